@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SyntheticData.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <iostream>
+
+/*! \file Generator.cpp
+ *
+ * Writes a synthetic model for load tests, i.e., a visual XML file and a matching MAT result file. The model can be
+ * visualized or benchmarked like any other result file, e.g., OMVIS --benchmark --model=synthetic_res.mat --path=./
+ */
+int main(int argc, char** argv)
+{
+    SyntheticModel model;
+
+    namespace po = boost::program_options;
+    po::options_description desc("Options");
+    desc.add_options()("help,h", "Prints help message.")(
+            "path", po::value<std::string>()->default_value("./"), "Directory the files are written to.")(
+            "name", po::value<std::string>()->default_value("synthetic"),
+            "Model name. The files are called NAME_visual.xml and NAME_res.mat.")(
+            "shapes", po::value<std::size_t>(&model.numShapes)->default_value(model.numShapes), "Number of shapes.")(
+            "rows", po::value<std::size_t>(&model.numRows)->default_value(model.numRows),
+            "Number of time points of the result file.")(
+            "dynamic", po::value<double>(&model.dynamicFraction)->default_value(model.dynamicFraction),
+            "Fraction in [0, 1] of the shapes with dynamic attributes.")(
+            "frames", po::value<std::size_t>(&model.numFrames)->default_value(model.numFrames),
+            "Number of moving frames shared by the dynamic shapes, each with 13 variables. 0 means one frame per "
+            "dynamic shape.")(
+            "stopTime", po::value<double>(&model.stopTime)->default_value(model.stopTime), "Time of the last row.");
+
+    po::variables_map vm;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+    }
+    catch (po::error& e)
+    {
+        std::cerr << "Cannot parse command line arguments. " << e.what() << std::endl;
+        return -1;
+    }
+
+    if (0u != vm.count("help"))
+    {
+        std::cout << "Usage: OMVISGenerator --shapes=100000 --rows=1000 --dynamic=0.1 --frames=100\n" << std::endl;
+        std::cout << desc << std::endl;
+        return 0;
+    }
+
+    if (0.0 > model.dynamicFraction || 1.0 < model.dynamicFraction || 0 == model.numRows)
+    {
+        std::cerr << "The fraction of dynamic shapes has to be in [0, 1] and there has to be a row." << std::endl;
+        return -1;
+    }
+
+    std::string path = vm["path"].as<std::string>();
+    if (!path.empty() && '/' != path.back())
+        path += '/';
+
+    try
+    {
+        writeSyntheticModel(path, vm["name"].as<std::string>(), model);
+    }
+    catch (std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return -1;
+    }
+    return 0;
+}
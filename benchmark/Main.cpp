@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkHarness.hpp"
+#include "BenchUtil.hpp"
+#include "BenchMatResultFile.hpp"
+#include "BenchShapes.hpp"
+#include "BenchFMUWrapper.hpp"
+
+#include "Util/Logger.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <fstream>
+#include <iostream>
+
+int main(int argc, char** argv)
+{
+    OMVIS::Util::LogSettings logSettings;
+    logSettings.setAll(OMVIS::Util::LL_ERROR);
+    OMVIS::Util::Logger::initialize(logSettings);
+
+    namespace po = boost::program_options;
+    po::options_description desc("Options");
+    desc.add_options()("help,h", "Prints help message.")(
+            "size", po::value<std::vector<std::size_t>>()->multitoken(),
+            "Number of items of the synthetic input, e.g., shapes, variables or faces. Several sizes can be given, "
+            "e.g., --size 10 1000 100000. Default: 1000.")(
+            "filter", po::value<std::string>()->default_value(""),
+            "Runs only the benchmarks whose name contains the given string.")(
+            "min-time", po::value<double>()->default_value(0.5), "Minimum time in seconds of every run.")(
+            "out", po::value<std::string>(), "Writes the JSON results to the given file instead of stdout.");
+
+    po::variables_map vm;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+    }
+    catch (po::error& e)
+    {
+        std::cerr << "Cannot parse command line arguments. " << e.what() << std::endl;
+        return -1;
+    }
+
+    if (0u != vm.count("help"))
+    {
+        std::cout << "Usage: OMVISBenchmarks --size 10 1000 --filter=BenchUtil --out=results.json\n" << std::endl;
+        std::cout << desc << std::endl;
+        return 0;
+    }
+
+    const std::vector<std::size_t> sizes =
+            (0u != vm.count("size")) ? vm["size"].as<std::vector<std::size_t>>() : std::vector<std::size_t>(1, 1000);
+    const std::string filter = vm["filter"].as<std::string>();
+    const double minTime = vm["min-time"].as<double>();
+
+    std::vector<BenchmarkResult> results;
+    for (const BenchmarkEntry& benchmark : getBenchmarks())
+    {
+        if (std::string::npos == benchmark.name.find(filter))
+            continue;
+
+        for (const std::size_t size : sizes)
+        {
+            BenchmarkState state(size, minTime);
+            try
+            {
+                benchmark.function(state);
+            }
+            catch (std::exception& ex)
+            {
+                std::cerr << benchmark.name << "/" << size << " failed: " << ex.what() << std::endl;
+                continue;
+            }
+            results.push_back(BenchmarkResult { benchmark.name, size, state.getIterations(),
+                                                state.getItemsPerIteration(), state.getRealTime(),
+                                                state.getCpuTime() });
+            std::cerr << benchmark.name << "/" << size << ": " << state.getIterations() << " iterations, "
+                      << 1.e9 * state.getRealTime() / state.getIterations() << " ns" << std::endl;
+        }
+    }
+
+    if (0u != vm.count("out"))
+    {
+        std::ofstream out(vm["out"].as<std::string>());
+        writeJson(out, results, argv[0], minTime);
+    }
+    else
+    {
+        writeJson(std::cout, results, argv[0], minTime);
+    }
+    return 0;
+}
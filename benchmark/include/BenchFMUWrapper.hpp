@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCHMARK_INCLUDE_BENCHFMUWRAPPER_HPP_
+#define BENCHMARK_INCLUDE_BENCHFMUWRAPPER_HPP_
+
+#include "BenchmarkHarness.hpp"
+#include "Model/FMUWrapper.hpp"
+
+#include <vector>
+
+/*!
+ * The explicit Euler step of FMUWrapper::doEulerStep for the given number of states.
+ */
+BENCHMARK (BenchFMUWrapper, EulerStep)
+{
+    std::vector<fmi1_real_t> states(state.getSize(), 1.0);
+    std::vector<fmi1_real_t> statesDer(state.getSize());
+    for (std::size_t i = 0; i < statesDer.size(); ++i)
+        statesDer[i] = 1.e-3 * static_cast<fmi1_real_t>(i % 17);
+    while (state.keepRunning())
+    {
+        OMVIS::Model::eulerStep(states.data(), statesDer.data(), 1.e-3, states.size());
+        doNotOptimize(states[0]);
+    }
+}
+
+#endif /* BENCHMARK_INCLUDE_BENCHFMUWRAPPER_HPP_ */
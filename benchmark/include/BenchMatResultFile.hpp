@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCHMARK_INCLUDE_BENCHMATRESULTFILE_HPP_
+#define BENCHMARK_INCLUDE_BENCHMATRESULTFILE_HPP_
+
+#include "BenchmarkHarness.hpp"
+#include "SyntheticData.hpp"
+#include "Model/MatResultFile.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/*! \brief A synthetic MAT file with the given number of variables and 1000 time points, which is removed again. */
+class SyntheticMatFile
+{
+ public:
+    explicit SyntheticMatFile(const std::size_t numVars)
+            : fileName(getTemporaryFileName(".mat")),
+              varNames(numVars)
+    {
+        for (std::size_t i = 0; i < numVars; ++i)
+            varNames[i] = "body" + std::to_string(i) + ".frame_a.r_0[1]";
+        writeMatFile(fileName, { "world.axisLength" }, { 0.5 }, varNames, 1000, 10.0,
+                     [numVars](std::size_t row, double* values)
+                     {
+                         for (std::size_t i = 0; i < numVars; ++i)
+                             values[i] = std::sin(0.01 * row + i);
+                     });
+    }
+
+    ~SyntheticMatFile()
+    {
+        std::remove(fileName.c_str());
+    }
+
+    std::string fileName;
+    std::vector<std::string> varNames;
+};
+
+/*!
+ * Looking up every variable by its name and reading its value at the current time, like omcGetVarValue.
+ */
+BENCHMARK (BenchMatResultFile, LookupByName)
+{
+    SyntheticMatFile file(state.getSize());
+    OMVIS::Model::MatResultFile matFile;
+    matFile.open(file.fileName);
+    OMVIS::Model::MatColumn column;
+    double time = 0.0;
+    while (state.keepRunning())
+    {
+        time = std::fmod(time + 0.01, 10.0);
+        matFile.seek(time);
+        for (const auto& varName : file.varNames)
+        {
+            matFile.findVariable(varName, column);
+            const double value = column.at(matFile.getCursorRow());
+            doNotOptimize(value);
+        }
+    }
+}
+
+/*!
+ * Interpolating all variables at the next frame time, as done by VisualizerMAT for resolved variables.
+ */
+BENCHMARK (BenchMatResultFile, Interpolate)
+{
+    SyntheticMatFile file(state.getSize());
+    OMVIS::Model::MatResultFile matFile;
+    matFile.open(file.fileName);
+    OMVIS::Model::MatColumnBatch batch;
+    OMVIS::Model::MatColumn column;
+    for (const auto& varName : file.varNames)
+    {
+        matFile.findVariable(varName, column);
+        matFile.addToBatch(column, batch);
+    }
+    std::vector<float> values(batch.size());
+    double time = 0.0;
+    while (state.keepRunning())
+    {
+        time = std::fmod(time + 0.01, 10.0);
+        matFile.seek(time);
+        matFile.interpolate(batch, values.data());
+        doNotOptimize(values[0]);
+    }
+}
+
+#endif /* BENCHMARK_INCLUDE_BENCHMATRESULTFILE_HPP_ */
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCHMARK_INCLUDE_BENCHSHAPES_HPP_
+#define BENCHMARK_INCLUDE_BENCHSHAPES_HPP_
+
+#include "BenchmarkHarness.hpp"
+#include "SyntheticData.hpp"
+#include "Model/Shapes/DXFile.hpp"
+#include "Model/Shapes/Pipecylinder.hpp"
+#include "Model/Shapes/Spring.hpp"
+
+#include <cstdio>
+
+/*!
+ * The construction of springs with different lengths, as for every changed spring of a frame.
+ */
+BENCHMARK (BenchShapes, Spring)
+{
+    while (state.keepRunning())
+    {
+        for (std::size_t i = 0; i < state.getSize(); ++i)
+        {
+            osg::ref_ptr<OMVIS::Model::Spring> spring = new OMVIS::Model::Spring(0.1f, 0.01f, 5.0f, 0.5f + 0.001f * i);
+            doNotOptimize(spring.get());
+        }
+    }
+}
+
+/*!
+ * The construction of pipes with different radii, as for every changed pipe of a frame.
+ */
+BENCHMARK (BenchShapes, Pipecylinder)
+{
+    while (state.keepRunning())
+    {
+        for (std::size_t i = 0; i < state.getSize(); ++i)
+        {
+            osg::ref_ptr<OMVIS::Model::Pipecylinder> pipe = new OMVIS::Model::Pipecylinder(0.05f, 0.1f + 0.001f * i,
+                                                                                           0.5f);
+            doNotOptimize(pipe.get());
+        }
+    }
+}
+
+/*!
+ * Parsing a DXF file with the given number of faces.
+ */
+BENCHMARK (BenchShapes, DXFile)
+{
+    const std::string fileName = getTemporaryFileName(".dxf");
+    writeDxfFile(fileName, state.getSize());
+    while (state.keepRunning())
+    {
+        osg::ref_ptr<OMVIS::Model::DXFile> dxf = new OMVIS::Model::DXFile(fileName);
+        doNotOptimize(dxf.get());
+    }
+    std::remove(fileName.c_str());
+}
+
+#endif /* BENCHMARK_INCLUDE_BENCHSHAPES_HPP_ */
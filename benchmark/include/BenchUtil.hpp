@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCHMARK_INCLUDE_BENCHUTIL_HPP_
+#define BENCHMARK_INCLUDE_BENCHUTIL_HPP_
+
+#include "BenchmarkHarness.hpp"
+#include "SyntheticData.hpp"
+#include "Model/ShapeTable.hpp"
+#include "Util/Expression.hpp"
+#include "Util/TransformKernel.hpp"
+#include "Util/Visualize.hpp"
+
+#include <random>
+#include <vector>
+
+/*! \brief Returns the given number of random directions. Every seventh one vanishes. */
+inline std::vector<osg::Vec3f> makeDirections(const std::size_t size, const unsigned int seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<osg::Vec3f> dirs(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if (0 != i % 7)
+            dirs[i].set(distribution(generator), distribution(generator), distribution(generator));
+    }
+    return dirs;
+}
+
+/*!
+ * The direction fixes of a shape.
+ */
+BENCHMARK (BenchUtil, FixDirections)
+{
+    const std::vector<osg::Vec3f> lDirs = makeDirections(state.getSize(), 1);
+    const std::vector<osg::Vec3f> wDirs = makeDirections(state.getSize(), 2);
+    while (state.keepRunning())
+    {
+        for (std::size_t i = 0; i < lDirs.size(); ++i)
+        {
+            OMVIS::Util::Directions dirs = OMVIS::Util::fixDirections(lDirs[i], wDirs[i]);
+            doNotOptimize(dirs);
+        }
+    }
+}
+
+/*!
+ * The transformation of a single shape, which is applied to every shape of a frame by the reference implementation.
+ */
+BENCHMARK (BenchUtil, Rotation)
+{
+    const std::vector<std::string> types = { "box", "cylinder", "sphere", "cone", "pipecylinder", "spring", "stl" };
+    const std::vector<osg::Vec3f> r = makeDirections(state.getSize(), 3);
+    const std::vector<osg::Vec3f> lDirs = makeDirections(state.getSize(), 4);
+    const std::vector<osg::Vec3f> wDirs = makeDirections(state.getSize(), 5);
+    const osg::Matrix3 T(0.0f, -1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+    while (state.keepRunning())
+    {
+        for (std::size_t i = 0; i < r.size(); ++i)
+        {
+            OMVIS::Util::rAndT rT = OMVIS::Util::rotation(r[i], r[i], T, lDirs[i], wDirs[i], 0.5f,
+                                                          types[i % types.size()]);
+            doNotOptimize(rT);
+        }
+    }
+}
+
+/*!
+ * The batched transformation of all shapes of a frame, which replaces the rotation of every single shape.
+ */
+BENCHMARK (BenchUtil, TransformBatch)
+{
+    const std::vector<std::string> types = { "box", "cylinder", "sphere", "cone", "pipecylinder", "spring", "stl" };
+    std::mt19937 generator(6);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<OMVIS::Model::ShapeObject> shapes(state.getSize());
+    for (std::size_t i = 0; i < shapes.size(); ++i)
+    {
+        shapes[i]._type = types[i % types.size()];
+        shapes[i]._shapeType = OMVIS::Model::getShapeTypeForString(shapes[i]._type);
+        for (auto attr : shapes[i].getAttributes())
+            attr->exp = distribution(generator);
+    }
+    OMVIS::Model::ShapeTable table;
+    table.build(shapes);
+    const OMVIS::Util::TransformInputs in = table.getTransformInputs();
+    while (state.keepRunning())
+    {
+        OMVIS::Util::transformBatch(in, 0, shapes.size(), table.getMatrices());
+        doNotOptimize(table.getMatrices()[0]);
+    }
+}
+
+/*!
+ * The evaluation of a visual XML expression with the given number of constants. Since the expression does not
+ * reference any variable, no FMU is needed.
+ */
+BENCHMARK (BenchUtil, EvaluateExpressionFMU)
+{
+    const std::string text = makeExpression(state.getSize());
+    std::vector<char> buffer(text.begin(), text.end());
+    buffer.push_back('\0');
+    rapidxml::xml_document<> doc;
+    doc.parse<0>(buffer.data());
+    while (state.keepRunning())
+    {
+        const double value = evaluateExpressionFMU(doc.first_node(), 0.0, nullptr);
+        doNotOptimize(value);
+    }
+}
+
+#endif /* BENCHMARK_INCLUDE_BENCHUTIL_HPP_ */
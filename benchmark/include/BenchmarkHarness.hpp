@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCHMARK_INCLUDE_BENCHMARKHARNESS_HPP_
+#define BENCHMARK_INCLUDE_BENCHMARKHARNESS_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <ctime>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*! \brief The state of one run of a benchmark.
+ *
+ * A benchmark prepares its synthetic input of \ref getSize items and runs its kernel afterwards in a loop
+ *
+ *      while (state.keepRunning())
+ *          kernel(input);
+ *
+ * Only the loop is measured. It runs until the minimum time has passed. Every iteration is expected to process
+ * \ref getItemsPerIteration items, which is the size by default.
+ */
+class BenchmarkState
+{
+ public:
+    BenchmarkState(const std::size_t size, const double minTime)
+            : _size(size),
+              _minTime(minTime),
+              _itemsPerIteration(size),
+              _iterations(0),
+              _realTime(0.0),
+              _cpuTime(0.0),
+              _realStart(),
+              _cpuStart(0)
+    {
+    }
+
+    /*! \brief Returns true, as long as the kernel has to be run once more. */
+    bool keepRunning()
+    {
+        if (0 == _iterations)
+        {
+            _cpuStart = std::clock();
+            _realStart = std::chrono::steady_clock::now();
+        }
+        else
+        {
+            _realTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - _realStart).count();
+            if (_realTime >= _minTime)
+            {
+                _cpuTime = static_cast<double>(std::clock() - _cpuStart) / CLOCKS_PER_SEC;
+                return false;
+            }
+        }
+        ++_iterations;
+        return true;
+    }
+
+    std::size_t getSize() const
+    {
+        return _size;
+    }
+
+    /*! \brief Sets the number of items processed by one iteration, if it differs from the size. */
+    void setItemsPerIteration(const std::size_t items)
+    {
+        _itemsPerIteration = items;
+    }
+
+    std::size_t getItemsPerIteration() const
+    {
+        return _itemsPerIteration;
+    }
+
+    std::size_t getIterations() const
+    {
+        return _iterations;
+    }
+
+    /*! \brief Returns the wall clock time of all iterations in seconds. */
+    double getRealTime() const
+    {
+        return _realTime;
+    }
+
+    /*! \brief Returns the processor time of all iterations in seconds. */
+    double getCpuTime() const
+    {
+        return _cpuTime;
+    }
+
+ private:
+    std::size_t _size;
+    double _minTime;
+    std::size_t _itemsPerIteration;
+    std::size_t _iterations;
+    double _realTime;
+    double _cpuTime;
+    std::chrono::steady_clock::time_point _realStart;
+    std::clock_t _cpuStart;
+};
+
+/*! \brief Prevents the compiler from removing the computation of the given value. */
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+#ifdef __GNUC__
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+using BenchmarkFunction = void (*)(BenchmarkState&);
+
+/*! \brief A registered benchmark, see \ref BENCHMARK. */
+struct BenchmarkEntry
+{
+    std::string name;
+    BenchmarkFunction function;
+};
+
+/*! \brief Returns all registered benchmarks in the order of registration. */
+inline std::vector<BenchmarkEntry>& getBenchmarks()
+{
+    static std::vector<BenchmarkEntry> benchmarks;
+    return benchmarks;
+}
+
+inline bool registerBenchmark(const std::string& name, const BenchmarkFunction function)
+{
+    getBenchmarks().push_back(BenchmarkEntry { name, function });
+    return true;
+}
+
+/*! \brief Defines and registers a benchmark named group.name, similar to the TEST macro of gtest. */
+#define BENCHMARK(group, name) \
+    static void group##_##name(BenchmarkState& state); \
+    static const bool group##_##name##_registered = registerBenchmark(#group "." #name, group##_##name); \
+    static void group##_##name(BenchmarkState& state)
+
+/*! \brief The result of one run of a benchmark. */
+struct BenchmarkResult
+{
+    std::string name;
+    std::size_t size;
+    std::size_t iterations;
+    std::size_t itemsPerIteration;
+    double realTime;
+    double cpuTime;
+};
+
+/*! \brief Writes the results in the JSON format of Google Benchmark, such that its tools can compare two runs.
+ *
+ * The times are given in nanoseconds per iteration.
+ */
+inline void writeJson(std::ostream& os, const std::vector<BenchmarkResult>& results, const std::string& executable,
+                      const double minTime)
+{
+    char date[64];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    os << "{\n";
+    os << "  \"context\": {\n";
+    os << "    \"date\": \"" << date << "\",\n";
+    os << "    \"executable\": \"" << executable << "\",\n";
+    os << "    \"min_time\": " << minTime << ",\n";
+#ifdef NDEBUG
+    os << "    \"library_build_type\": \"release\"\n";
+#else
+    os << "    \"library_build_type\": \"debug\"\n";
+#endif
+    os << "  },\n";
+    os << "  \"benchmarks\": [";
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const BenchmarkResult& result = results[i];
+        const double iterations = static_cast<double>(result.iterations);
+        const double items = iterations * result.itemsPerIteration;
+        os << ((0 == i) ? "\n" : ",\n");
+        os << "    {\n";
+        os << "      \"name\": \"" << result.name << "/" << result.size << "\",\n";
+        os << "      \"run_name\": \"" << result.name << "/" << result.size << "\",\n";
+        os << "      \"run_type\": \"iteration\",\n";
+        os << "      \"size\": " << result.size << ",\n";
+        os << "      \"iterations\": " << result.iterations << ",\n";
+        os << "      \"real_time\": " << 1.e9 * result.realTime / iterations << ",\n";
+        os << "      \"cpu_time\": " << 1.e9 * result.cpuTime / iterations << ",\n";
+        os << "      \"time_unit\": \"ns\",\n";
+        os << "      \"items_per_second\": " << ((0.0 < result.realTime) ? items / result.realTime : 0.0) << "\n";
+        os << "    }";
+    }
+    os << "\n  ]\n";
+    os << "}" << std::endl;
+}
+
+#endif /* BENCHMARK_INCLUDE_BENCHMARKHARNESS_HPP_ */
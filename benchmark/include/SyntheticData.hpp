@@ -0,0 +1,312 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCHMARK_INCLUDE_SYNTHETICDATA_HPP_
+#define BENCHMARK_INCLUDE_SYNTHETICDATA_HPP_
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*! \brief Returns a unique file name with the given extension in the temporary directory. */
+inline std::string getTemporaryFileName(const std::string& extension)
+{
+    const auto path = boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("omvis-%%%%-%%%%-%%%%" + extension);
+    return path.string();
+}
+
+/*! \brief Writes the header and the name of a MAT v4 matrix. */
+inline void writeMatHeader(std::ofstream& out, const std::int32_t type, const std::size_t mrows,
+                           const std::size_t ncols, const std::string& name)
+{
+    const std::int32_t header[5] = { type, static_cast<std::int32_t>(mrows), static_cast<std::int32_t>(ncols), 0,
+                                     static_cast<std::int32_t>(name.size() + 1) };
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+    out.write(name.c_str(), name.size() + 1);
+}
+
+/*! \brief Writes a text matrix with one string per column, padded with blanks to the longest string. */
+inline void writeMatStrings(std::ofstream& out, const std::string& name, const std::vector<std::string>& strings)
+{
+    std::size_t maxLen = 1;
+    for (const auto& str : strings)
+        maxLen = std::max(maxLen, str.size());
+    writeMatHeader(out, 51, maxLen, strings.size(), name);
+    std::string padded;
+    for (const auto& str : strings)
+    {
+        padded = str;
+        padded.resize(maxLen, ' ');
+        out.write(padded.data(), maxLen);
+    }
+}
+
+/*! \brief Writes an OpenModelica result file in MAT v4 format with transposed storage.
+ *
+ * The file has the same structure as the files written by the OpenModelica runtime, i.e., the time and the
+ * parameters are stored in data_1 and the time and the variables in data_2. The values are written row by row, such
+ * that files with millions of time points do not need to fit into memory.
+ *
+ * \param fileName      Name of the file.
+ * \param paramNames    Names of the parameters.
+ * \param paramValues   Values of the parameters.
+ * \param varNames      Names of the time dependent variables without the time.
+ * \param numRows       Number of time points.
+ * \param stopTime      The time of the last row. The rows are equidistant and start at 0.
+ * \param fillRow       Writes the values of all variables of the given row to the given array.
+ */
+inline void writeMatFile(const std::string& fileName, const std::vector<std::string>& paramNames,
+                         const std::vector<double>& paramValues, const std::vector<std::string>& varNames,
+                         const std::size_t numRows, const double stopTime,
+                         const std::function<void(std::size_t, double*)>& fillRow)
+{
+    std::ofstream out(fileName, std::ios::binary);
+    if (!out)
+        throw std::runtime_error("Could not write MAT file " + fileName + ".");
+
+    // Aclass is stored row major in four rows of eleven characters. The fourth row tells the storage.
+    const char aclass[4][12] = { "Atrajectory", "1.1        ", "           ", "binTrans   " };
+    writeMatHeader(out, 51, 4, 11, "Aclass");
+    for (std::size_t c = 0; c < 11; ++c)
+    {
+        for (std::size_t r = 0; r < 4; ++r)
+            out.put(aclass[r][c]);
+    }
+
+    std::vector<std::string> names(1, "time");
+    names.insert(names.end(), paramNames.begin(), paramNames.end());
+    names.insert(names.end(), varNames.begin(), varNames.end());
+    writeMatStrings(out, "name", names);
+    writeMatStrings(out, "description", std::vector<std::string>(names.size(), ""));
+
+    // dataInfo: data set, column (1-based), interpolation, extrapolation for every name.
+    writeMatHeader(out, 20, 4, names.size(), "dataInfo");
+    std::vector<std::int32_t> info;
+    info.reserve(4 * names.size());
+    info.insert(info.end(), { 0, 1, 0, -1 });
+    for (std::size_t i = 0; i < paramNames.size(); ++i)
+        info.insert(info.end(), { 1, static_cast<std::int32_t>(i + 2), 0, 0 });
+    for (std::size_t i = 0; i < varNames.size(); ++i)
+        info.insert(info.end(), { 2, static_cast<std::int32_t>(i + 2), 0, -1 });
+    out.write(reinterpret_cast<const char*>(info.data()), info.size() * sizeof(std::int32_t));
+
+    // data_1 holds the parameters at the start and the stop time.
+    writeMatHeader(out, 0, 1 + paramNames.size(), 2, "data_1");
+    for (const double time : { 0.0, stopTime })
+    {
+        out.write(reinterpret_cast<const char*>(&time), sizeof(double));
+        out.write(reinterpret_cast<const char*>(paramValues.data()), paramValues.size() * sizeof(double));
+    }
+
+    writeMatHeader(out, 0, 1 + varNames.size(), numRows, "data_2");
+    std::vector<double> row(1 + varNames.size());
+    for (std::size_t rowIdx = 0; rowIdx < numRows; ++rowIdx)
+    {
+        row[0] = (1 < numRows) ? stopTime * rowIdx / (numRows - 1) : 0.0;
+        fillRow(rowIdx, row.data() + 1);
+        out.write(reinterpret_cast<const char*>(row.data()), row.size() * sizeof(double));
+    }
+
+    if (!out)
+        throw std::runtime_error("Could not write MAT file " + fileName + ".");
+}
+
+/*! \brief Writes a DXF file with the given number of 3DFACE entities, which are alternately quads and triangles. */
+inline void writeDxfFile(const std::string& fileName, const std::size_t numFaces)
+{
+    std::ofstream out(fileName);
+    if (!out)
+        throw std::runtime_error("Could not write DXF file " + fileName + ".");
+
+    out << "0\nSECTION\n2\nENTITIES\n";
+    for (std::size_t i = 0; i < numFaces; ++i)
+    {
+        const double x = static_cast<double>(i % 100);
+        const double y = static_cast<double>(i / 100);
+        const double corners[4][3] = { { x, y, 0.0 }, { x + 1.0, y, 0.0 }, { x + 1.0, y + 1.0, 0.5 },
+                                       { x, y + 1.0, 0.5 } };
+        out << "0\n3DFACE\n8\n0\n62\n" << (i % 5) << "\n";
+        for (int corner = 0; corner < 4; ++corner)
+        {
+            // Triangles repeat the first corner.
+            const double* p = (3 == corner && 1 == i % 2) ? corners[0] : corners[corner];
+            for (int k = 0; k < 3; ++k)
+                out << (10 * (k + 1) + corner) << "\n" << p[k] << "\n";
+        }
+    }
+    out << "0\nENDSEC\n0\nEOF\n";
+}
+
+/*! \brief Returns a visual XML expression, i.e., a balanced tree of binary operations on the given number of
+ *         constants.
+ */
+inline std::string makeExpression(const std::size_t numLeaves)
+{
+    if (1 >= numLeaves)
+        return "<exp>1.0001</exp>";
+    const std::size_t left = numLeaves / 2;
+    const char* op = (0 == numLeaves % 2) ? "add" : "mul";
+    return "<binary>" + makeExpression(left) + "<op>" + op + "</op>" + makeExpression(numLeaves - left)
+            + "</binary>";
+}
+
+/*! \brief The parameters of a synthetic model for load tests, see \ref writeSyntheticModel. */
+struct SyntheticModel
+{
+    //! Number of shapes, which cycle through box, cylinder, sphere, cone, pipecylinder and spring.
+    std::size_t numShapes = 1000;
+    //! Number of time points of the result file.
+    std::size_t numRows = 1000;
+    //! Fraction in [0, 1] of the shapes that move. All attributes of the other shapes are constant expressions.
+    double dynamicFraction = 0.5;
+    //! Number of moving frames the dynamic shapes are attached to. 0 means one frame per dynamic shape.
+    std::size_t numFrames = 0;
+    //! Time of the last time point.
+    double stopTime = 10.0;
+};
+
+/*! \brief Writes a synthetic model, i.e., the visual XML file NAME_visual.xml and the result file NAME_res.mat.
+ *
+ * The dynamic shapes are distributed evenly over all shapes and attached to the moving frames round robin. A frame
+ * has 13 variables in the result file: its position r_0[1..3] on a circle, its rotation R.T[1,1..3,3] about the z axis
+ * and a length, which is referenced by every fourth shape of the frame. Thus, the number of variables and the share
+ * of dynamic attributes can be controlled independently of the number of shapes.
+ *
+ * \param path     Directory of the files.
+ * \param name     Model name, i.e., the prefix of the file names.
+ * \param model    Size and sparsity of the model.
+ */
+inline void writeSyntheticModel(const std::string& path, const std::string& name, const SyntheticModel& model)
+{
+    const char* types[] = { "box", "cylinder", "sphere", "cone", "pipecylinder", "spring" };
+    const char* frameSuffixes[13] = { "r_0[1]", "r_0[2]", "r_0[3]", "R.T[1,1]", "R.T[1,2]", "R.T[1,3]", "R.T[2,1]",
+                                      "R.T[2,2]", "R.T[2,3]", "R.T[3,1]", "R.T[3,2]", "R.T[3,3]", "length" };
+
+    std::size_t numDynamic = 0;
+    for (std::size_t i = 0; i < model.numShapes; ++i)
+    {
+        if (std::floor((i + 1) * model.dynamicFraction) > std::floor(i * model.dynamicFraction))
+            ++numDynamic;
+    }
+    const std::size_t numFrames = (0 == model.numFrames) ? numDynamic : std::min(model.numFrames, numDynamic);
+    const std::size_t gridSize = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(model.numShapes))));
+
+    const std::string xmlFileName = path + name + "_visual.xml";
+    std::ofstream xml(xmlFileName);
+    if (!xml)
+        throw std::runtime_error("Could not write visual XML file " + xmlFileName + ".");
+
+    auto writeExps = [&xml](const char* tag, std::initializer_list<double> values)
+    {
+        xml << "    <" << tag << ">";
+        for (const double value : values)
+            xml << "<exp>" << value << "</exp>";
+        xml << "</" << tag << ">\n";
+    };
+
+    xml << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n<visualization>\n";
+    std::size_t dynamicIdx = 0;
+    for (std::size_t i = 0; i < model.numShapes; ++i)
+    {
+        const std::size_t typeIdx = i % 6;
+        const bool dynamic = std::floor((i + 1) * model.dynamicFraction) > std::floor(i * model.dynamicFraction);
+        const double x = static_cast<double>(i % gridSize);
+        const double y = static_cast<double>(i / gridSize);
+        const double size = 0.2 + 0.1 * (i % 3);
+        const double extra = (4 == typeIdx) ? 0.5 : ((5 == typeIdx) ? 5.0 : 0.0);
+
+        xml << "  <shape>\n    <ident>shape" << i << "</ident>\n    <type>" << types[typeIdx] << "</type>\n";
+        if (dynamic)
+        {
+            const std::string frame = "frame" + std::to_string(dynamicIdx % numFrames) + ".";
+            xml << "    <T>";
+            for (std::size_t k = 3; k < 12; ++k)
+                xml << "<cref>" << frame << frameSuffixes[k] << "</cref>";
+            xml << "</T>\n    <r>";
+            for (std::size_t k = 0; k < 3; ++k)
+                xml << "<cref>" << frame << frameSuffixes[k] << "</cref>";
+            xml << "</r>\n";
+            writeExps("r_shape", { 0.0, 0.0, 0.1 * (dynamicIdx / numFrames) });
+            if (0 == (dynamicIdx / numFrames) % 4)
+                xml << "    <length><cref>" << frame << frameSuffixes[12] << "</cref></length>\n";
+            else
+                writeExps("length", { size });
+            ++dynamicIdx;
+        }
+        else
+        {
+            writeExps("T", { 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0 });
+            writeExps("r", { x, y, 0.0 });
+            writeExps("r_shape", { 0.0, 0.0, 0.0 });
+            writeExps("length", { size });
+        }
+        writeExps("lengthDir", { 1.0, 0.0, 0.0 });
+        writeExps("widthDir", { 0.0, 1.0, 0.0 });
+        writeExps("width", { 0.5 * size });
+        writeExps("height", { 0.5 * size });
+        writeExps("extra", { extra });
+        writeExps("color", { 50.0 * typeIdx, dynamic ? 200.0 : 100.0, 255.0 - 40.0 * typeIdx });
+        writeExps("specCoeff", { 0.5 });
+        xml << "  </shape>\n";
+    }
+    xml << "</visualization>\n";
+    xml.close();
+    if (!xml)
+        throw std::runtime_error("Could not write visual XML file " + xmlFileName + ".");
+
+    // The frames move on circles around grid points with different speeds.
+    std::vector<std::string> varNames;
+    varNames.reserve(13 * numFrames);
+    for (std::size_t frameIdx = 0; frameIdx < numFrames; ++frameIdx)
+    {
+        for (const char* suffix : frameSuffixes)
+            varNames.push_back("frame" + std::to_string(frameIdx) + "." + suffix);
+    }
+    const double stopTime = model.stopTime;
+    const std::size_t numRows = model.numRows;
+    writeMatFile(path + name + "_res.mat", { "world.axisLength" }, { 1.0 }, varNames, numRows, stopTime,
+                 [numFrames, gridSize, stopTime, numRows](std::size_t row, double* values)
+                 {
+                     const double time = (1 < numRows) ? stopTime * row / (numRows - 1) : 0.0;
+                     for (std::size_t frameIdx = 0; frameIdx < numFrames; ++frameIdx)
+                     {
+                         const double phi = (1.0 + 0.1 * (frameIdx % 10)) * time + 0.5 * frameIdx;
+                         const double c = std::cos(phi);
+                         const double s = std::sin(phi);
+                         double* v = values + 13 * frameIdx;
+                         v[0] = static_cast<double>(frameIdx % gridSize) + 0.4 * c;
+                         v[1] = static_cast<double>(frameIdx / gridSize) + 0.4 * s;
+                         v[2] = 0.5;
+                         const double T[9] = { c, s, 0.0, -s, c, 0.0, 0.0, 0.0, 1.0 };
+                         std::copy(T, T + 9, v + 3);
+                         v[12] = 0.3 + 0.1 * s;
+                     }
+                 });
+}
+
+#endif /* BENCHMARK_INCLUDE_SYNTHETICDATA_HPP_ */
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Control
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_BENCHMARK_HPP_
+#define INCLUDE_BENCHMARK_HPP_
+
+#include "Model/VisualizerAbstract.hpp"
+#include "Util/StageTimer.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+
+namespace OMVIS
+{
+    namespace Control
+    {
+
+        /*! \brief Replays a model without a window and measures the stages of its frames.
+         *
+         * The visualizer is initialized as by the GUI, i.e., the scene graph is set up, but it is neither attached to
+         * a viewer nor rendered. Afterwards, the whole time line is played by
+         * \ref Model::VisualizerAbstract::sceneUpdate as fast as possible. The times of the stages of every frame are
+         * summed up, see \ref Util::FrameStage.
+         *
+         * This is used by the command line option --benchmark.
+         */
+        class Benchmark
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            Benchmark() = delete;
+
+            /*! \brief Constructs a benchmark of the given visualizer, which has not been initialized yet. */
+            explicit Benchmark(std::shared_ptr<Model::VisualizerAbstract> visualizer);
+
+            ~Benchmark() = default;
+
+            Benchmark(const Benchmark& rhs) = delete;
+
+            Benchmark& operator=(const Benchmark& rhs) = delete;
+
+            /*-----------------------------------------
+             * SIMULATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Initializes the visualizer and plays the time line from the start to the end time. */
+            void run();
+
+            /*-----------------------------------------
+             * GETTERS and SETTERS
+             *---------------------------------------*/
+
+            /*! \brief Returns the number of frames played by \ref run. */
+            std::size_t getNumFrames() const;
+
+            /*! \brief Returns the number of frames per second, i.e., without the initialization. */
+            double getFramesPerSecond() const;
+
+            /*! \brief Returns the total time of each stage of all frames in seconds. */
+            const Util::FrameTimes& getTotalTimes() const;
+
+            /*! \brief Returns the maximum time of each stage of a single frame in seconds. */
+            const Util::FrameTimes& getMaxTimes() const;
+
+            /*! \brief Returns the peak resident set size of the process in bytes or 0, if it is unknown. */
+            static std::size_t getPeakRSS();
+
+            /*-----------------------------------------
+             * PRINT METHODS
+             *---------------------------------------*/
+
+            /*! \brief Writes the results of \ref run as a table. */
+            void print(std::ostream& os) const;
+
+         private:
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            std::shared_ptr<Model::VisualizerAbstract> _visualizer;
+            std::size_t _numFrames;
+            //! Wall clock time of the initialization in seconds.
+            double _initTime;
+            //! Wall clock time of all frames in seconds.
+            double _playTime;
+            Util::FrameTimes _totalTimes;
+            Util::FrameTimes _maxTimes;
+        };
+
+    }  // namespace Control
+}  // namespace OMVIS
+
+#endif /* INCLUDE_BENCHMARK_HPP_ */
+/**
+ * \}
+ */
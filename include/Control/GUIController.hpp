@@ -179,6 +179,7 @@ namespace OMVIS
             bool visTypeIsFMURemote() const;
             bool visTypeIsMAT() const;
             bool visTypeIsMATRemote() const;
+            bool visTypeIsCSV() const;
 
             /*! \brief Returns name of the model. */
             std::string getModelFile() const;
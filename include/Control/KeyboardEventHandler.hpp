@@ -27,6 +27,7 @@
 #ifndef INCLUDE_CONTROL_KEYBOARDEVENTHANDLER_HPP_
 #define INCLUDE_CONTROL_KEYBOARDEVENTHANDLER_HPP_
 
+#include <osg/Node>
 #include <osgGA/GUIEventHandler>
 
 #include <memory>
@@ -46,11 +47,16 @@ namespace OMVIS
 
         /*! \brief This class handles keyboard events.
          *
-         * Inherits from osg GUIEventHandler.
+         * Inherits from osg GUIEventHandler. The keys of the keyboard map of the input data are passed to the model
+         * inputs. The key \a statisticsKey shows or hides the statistics overlay. Its events are always marked as
+         * handled, thus the key is never passed to the model inputs or to other handlers.
          */
         class KeyboardEventHandler : public osgGA::GUIEventHandler
         {
          public:
+            /*! \brief The key which toggles the statistics overlay. */
+            static constexpr int statisticsKey = 'p';
+
             /*-----------------------------------------
              * CONSTRUCTORS
              *---------------------------------------*/
@@ -60,9 +66,11 @@ namespace OMVIS
 
             /*! \brief Constructs KeyboardEventHandler from InputData argument.
              *
-             * @param inputs
+             * @param inputs                The inputs of the model or nullptr, if there are none.
+             * @param statisticsOverlay     The node that shows the stage statistics or nullptr.
              */
-            KeyboardEventHandler(std::shared_ptr<Model::InputData> inputs);
+            KeyboardEventHandler(std::shared_ptr<Model::InputData> inputs,
+                                 osg::ref_ptr<osg::Node> statisticsOverlay = nullptr);
 
             /// Let the compiler provide the destructor.
             ~KeyboardEventHandler() = default;
@@ -89,6 +97,7 @@ namespace OMVIS
              *---------------------------------------*/
 
             std::shared_ptr<Model::InputData> _inputs;
+            osg::ref_ptr<osg::Node> _statisticsOverlay;
         };
 
     }  // namespace Control
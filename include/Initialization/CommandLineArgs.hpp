@@ -112,6 +112,12 @@ namespace OMVIS
             std::string modelFile;
             std::string modelPath;
             std::string wDir;
+            //! If true, OMVIS bakes the transformations of a MAT result file and exits without opening a window.
+            bool bake;
+            //! If true, OMVIS replays the model without opening a window, prints the frame timings and exits.
+            bool benchmark;
+            //! If not empty, the events of the session are written to this file in the Chrome trace format.
+            std::string trace;
             Util::LogSettings logSet;
         };
 
@@ -121,6 +127,9 @@ namespace OMVIS
          *      --help                          Prints help message.
          *      --model=/PATH/TO/MODELNAME      Path (absolute or relative) to the model which should be visualized.
          *      --useFMU                        OMVIS uses a FMU if specified for visualization.
+         *      --bake                          Precompute the shape transformations of a MAT file and exit.
+         *      --benchmark                     Replay the model without a window, print the timings and exit.
+         *      --trace=trace.json              Write the events of the session to a Chrome trace file.
          *      --loggersettings="loader=warning"
          *
          * \param argc
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Model
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_BAKEDTRANSFORMS_HPP_
+#define INCLUDE_BAKEDTRANSFORMS_HPP_
+
+#include "Util/MappedFile.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        class ShapeObject;
+
+        /*! \brief The precomputed state of one shape at one output time of a MAT result file. */
+        struct BakedShape
+        {
+            //! The final 4x4 transformation matrix of the shape in row major order.
+            float mat[16];
+            float color[3];
+            float length;
+            float width;
+            float height;
+            float extra;
+        };
+
+        /*! \brief Header of a baked transformation file.
+         *
+         * The header is followed by \a numRows time values (double) and \a numRows frames of \a numShapes
+         * \ref BakedShape records each. Size and modification time of the MAT file and the modification time of the
+         * visual XML file are stored to detect stale files.
+         */
+        struct BakedHeader
+        {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t numShapes;
+            std::uint64_t numRows;
+            std::uint64_t matFileSize;
+            std::int64_t matFileTime;
+            std::int64_t xmlFileTime;
+        };
+
+        /*! \brief Memory-mapped read access to a baked transformation file.
+         *
+         * A baked transformation file is written by \ref VisualizerMAT::bake. It contains the final matrix, colour and
+         * size of every shape for every output time of a MAT result file. Thus, scrubbing through the result does not
+         * need any transformation at all. Between two output times, the records of both frames are interpolated
+         * linearly, like the result values are interpolated without the baked file.
+         */
+        class BakedTransforms
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            BakedTransforms();
+
+            ~BakedTransforms();
+
+            BakedTransforms(const BakedTransforms& rhs) = delete;
+
+            BakedTransforms& operator=(const BakedTransforms& rhs) = delete;
+
+            /*-----------------------------------------
+             * INITIALIZATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Creates the header of a baked transformation file for the given MAT file.
+             *
+             * \param matFileName   The MAT file the transformations are computed from.
+             * \param xmlFileName   The visual XML file the shapes are defined in.
+             * \param numShapes     Number of shapes per frame.
+             * \param numRows       Number of frames, i.e., output times.
+             */
+            static BakedHeader makeHeader(const std::string& matFileName, const std::string& xmlFileName,
+                                          const std::size_t numShapes, const std::size_t numRows);
+
+            /*! \brief Maps a baked transformation file into memory.
+             *
+             * The file is only used if it belongs to the current version of the MAT file and the given number of
+             * shapes. Missing or stale files are not an error, since baking is optional.
+             *
+             * \param fileName      The baked transformation file.
+             * \param matFileName   The MAT file the transformations have to belong to.
+             * \param xmlFileName   The visual XML file the transformations have to belong to.
+             * \param numShapes     Number of shapes of the current scene.
+             * \return True, if the file has been mapped.
+             */
+            bool open(const std::string& fileName, const std::string& matFileName, const std::string& xmlFileName,
+                      const std::size_t numShapes);
+
+            /*! \brief Unmaps the file. */
+            void close();
+
+            /*-----------------------------------------
+             * GETTERS and SETTERS
+             *---------------------------------------*/
+
+            /*! \brief Returns true, if a file is mapped. */
+            bool isOpen() const;
+
+            /*! \brief Returns the lower of the two rows bracketing the given time.
+             *
+             * \param time    The time. Times outside of the file are clamped to the first or last row.
+             * \param weight  The interpolation weight of the upper row, which is 0.0 if the time is on a row.
+             */
+            std::size_t findRow(const double time, float& weight) const;
+
+            /*! \brief Returns the records of all shapes of the given row. */
+            const BakedShape* getFrame(const std::size_t row) const;
+
+            /*! \brief Stores the final matrix, colour and size of the shape in the record. */
+            static void record(const ShapeObject& shape, BakedShape& rec);
+
+            /*! \brief Interpolates two records linearly.
+             *
+             * \param lo      The record at the lower row.
+             * \param hi      The record at the upper row.
+             * \param weight  The interpolation weight of the upper row.
+             * \param rec     The interpolated record.
+             */
+            static void interpolate(const BakedShape& lo, const BakedShape& hi, const float weight, BakedShape& rec);
+
+            /*! \brief Copies the matrix, colour and size of the record into the shape.
+             *
+             * \return True, if any value of the shape has changed.
+             */
+            static bool restore(const BakedShape& rec, ShapeObject& shape);
+
+         private:
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            //! The mapping of the file.
+            Util::MappedFile _file;
+            //! Start address and size of \a _file.
+            const char* _data;
+            std::size_t _size;
+            //! Number of shapes per frame.
+            std::size_t _numShapes;
+            //! Number of frames.
+            std::size_t _numRows;
+            //! The time values of the frames.
+            const double* _times;
+            //! The first frame.
+            const BakedShape* _frames;
+        };
+
+    }  // namespace Model
+}  // namespace OMVIS
+
+#endif /* INCLUDE_BAKEDTRANSFORMS_HPP_ */
+/**
+ * \}
+ */
@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Model
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_CSVRESULTFILE_HPP_
+#define INCLUDE_CSVRESULTFILE_HPP_
+
+#include "Util/MappedFile.hpp"
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*! \brief Memory-mapped reader for OpenModelica result files in CSV format.
+         *
+         * The first line holds the (optionally quoted) variable names, the first column is the time. Each following
+         * line holds the values of one output time point.
+         *
+         * The file is not parsed as a whole. When it is opened, only the line breaks are searched and the time of every
+         * \a indexStride -th row is parsed into a sparse row index. Looking up a time is a binary search in this index
+         * followed by parsing the first field of at most \a indexStride rows. The values of a row are tokenized in
+         * place, without any heap allocation, and only the requested columns are converted.
+         *
+         * Usage: Call \ref seek once per frame and read the bracketing rows with \ref readRow.
+         */
+        class CsvResultFile
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            CsvResultFile();
+
+            ~CsvResultFile();
+
+            CsvResultFile(const CsvResultFile& rhs) = delete;
+
+            CsvResultFile& operator=(const CsvResultFile& rhs) = delete;
+
+            /*-----------------------------------------
+             * INITIALIZATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Maps the given CSV file into memory, parses its header and builds the sparse row index.
+             *
+             * If another file is already open, it is closed first.
+             *
+             * \param fileName  Absolute path to the CSV file.
+             * \throws std::runtime_error if the file cannot be mapped or does not contain a header and a data row.
+             */
+            void open(const std::string& fileName);
+
+            /*! \brief Unmaps the file. */
+            void close();
+
+            /*-----------------------------------------
+             * GETTERS and SETTERS
+             *---------------------------------------*/
+
+            /*! \brief Returns true, if a file is mapped. */
+            bool isOpen() const;
+
+            /*! \brief Looks up the column of the variable with the given name.
+             *
+             * \param varName   Name of the variable, e.g., world.x_label.R.T[1,1].
+             * \param column    The resulting column. Unchanged, if the variable does not exist.
+             * \return True, if the variable has been found.
+             */
+            bool findVariable(const std::string& varName, std::size_t& column) const;
+
+            /*! \brief Returns the number of stored output time points. */
+            std::size_t getNumRows() const;
+
+            /*! \brief Returns the first time value of the result. */
+            double getStartTime() const;
+
+            /*! \brief Returns the last time value of the result. */
+            double getStopTime() const;
+
+            /*! \brief Returns the time value of the given row. */
+            double getTime(const std::size_t row) const;
+
+            /*-----------------------------------------
+             * SIMULATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Moves the cursor to the given time.
+             *
+             * As long as the time stays between the bracketing rows, nothing is parsed at all. During forward playback
+             * the cursor is moved row by row, otherwise the sparse row index is used. Times outside of the result are
+             * clamped to the first or last row.
+             *
+             * \param time  The time to move the cursor to.
+             */
+            void seek(const double time);
+
+            /*! \brief Returns the lower of the two rows bracketing the current cursor time. */
+            std::size_t getCursorRow() const;
+
+            /*! \brief Returns the interpolation weight of the upper bracketing row at the current cursor time. */
+            double getCursorWeight() const;
+
+            /*! \brief Reads the values of the given columns in the given row.
+             *
+             * \param row       The row to read.
+             * \param columns   The columns to read in ascending order.
+             * \param values    Output array with at least columns.size() elements. Values of missing fields are 0.0.
+             */
+            void readRow(const std::size_t row, const std::vector<std::size_t>& columns, double* values) const;
+
+         private:
+            /*-----------------------------------------
+             * PRIVATE METHODS
+             *---------------------------------------*/
+
+            /*! \brief Maps the file into memory. */
+            void mapFile(const std::string& fileName);
+
+            /*! \brief Splits the header line into the variable names. */
+            void parseHeader();
+
+            /*! \brief Counts the rows and records the offset and time of every \a indexStride -th row. */
+            void buildIndex();
+
+            /*! \brief Returns the first character of the given row. */
+            const char* rowBegin(const std::size_t row) const;
+
+            /*! \brief Returns the first character after the line break of the row starting at pos. */
+            const char* nextRow(const char* pos) const;
+
+            /*! \brief Converts the field [begin, end) to a double without touching the heap.
+             *
+             * The field is copied to a buffer on the stack, since strtod would read beyond the end of the mapping if
+             * the file ends with a digit. The value is parsed in the C locale.
+             *
+             * \throws std::runtime_error, if the field is not a number as a whole.
+             */
+            double parseValue(const char* begin, const char* end) const;
+
+            /*! \brief Moves the cursor onto the given row whose first character is pos. */
+            void setCursor(const std::size_t row, const char* pos);
+
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            //! Number of rows between two entries of the sparse row index.
+            static constexpr std::size_t indexStride = 64;
+
+            //! Name of the mapped file.
+            std::string _fileName;
+            //! The mapping of the file.
+            Util::MappedFile _file;
+            //! Start address and size of \a _file.
+            const char* _data;
+            std::size_t _size;
+
+            //! Maps variable names to their column.
+            std::unordered_map<std::string, std::size_t> _varIndices;
+            //! Byte offset of every \a indexStride -th row.
+            std::vector<std::size_t> _rowOffsets;
+            //! Time value of every \a indexStride -th row.
+            std::vector<double> _rowTimes;
+            //! Number of data rows.
+            std::size_t _numRows;
+            //! Time value of the last row.
+            double _stopTime;
+
+            //! Lower bracketing row of the current cursor time.
+            std::size_t _cursorRow;
+            //! Interpolation weight of the row \a _cursorRow + 1.
+            double _cursorWeight;
+            //! First characters of the rows \a _cursorRow and \a _cursorRow + 1.
+            const char* _cursorPos[2];
+            //! Time values of the rows \a _cursorRow and \a _cursorRow + 1.
+            double _cursorTime[2];
+        };
+
+    }  // namespace Model
+}  // namespace OMVIS
+
+#endif /* INCLUDE_CSVRESULTFILE_HPP_ */
+/**
+ * \}
+ */
@@ -180,6 +180,12 @@ namespace OMVIS
         /// \todo Todo Do we need this method?
         fmi1_base_type_enu_t getFMI1baseTypeFor4CharString(const std::string& typeString);
 
+        /*! \brief Performs a step of the Forward Euler algorithm, i.e., states += h * statesDer.
+         *
+         * This is the kernel of \ref FMUWrapper::doEulerStep, which does not need a loaded FMU.
+         */
+        void eulerStep(fmi1_real_t* states, const fmi1_real_t* statesDer, const fmi1_real_t h, const size_t nStates);
+
     }  // namespace Model
 }  // namespace OMVIS
 
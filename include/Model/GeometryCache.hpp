@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Model
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_GEOMETRYCACHE_HPP_
+#define INCLUDE_GEOMETRYCACHE_HPP_
+
+#include "Model/ShapeType.hpp"
+
+#include <osg/Geometry>
+#include <osg/ref_ptr>
+
+#include <array>
+#include <cstddef>
+#include <unordered_map>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*! \brief Cache of the generated geometries of pipes, pipe cylinders and springs.
+         *
+         * The geometries are keyed on their parameters, quantized to \a quantum. Shapes with equal quantized
+         * parameters share one geometry. The cached geometries have data variance STATIC and must not be changed.
+         * A shape whose length changes from frame to frame gets a private geometry with data variance DYNAMIC
+         * instead, which is updated in place.
+         */
+        class GeometryCache
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            GeometryCache();
+
+            ~GeometryCache() = default;
+
+            GeometryCache(const GeometryCache& rhs) = delete;
+
+            GeometryCache& operator=(const GeometryCache& rhs) = delete;
+
+            /*-----------------------------------------
+             * GETTERS and SETTERS
+             *---------------------------------------*/
+
+            /*! \brief Returns a shared \ref Pipecylinder with the given parameters. */
+            osg::Geometry* getPipecylinder(const float rI, const float rO, const float l);
+
+            /*! \brief Returns a shared \ref Spring with the given parameters. */
+            osg::Geometry* getSpring(const float r, const float rCoil, const float nWindings, const float l);
+
+            /*! \brief Returns the number of cached geometries. */
+            std::size_t getSize() const;
+
+            /*! \brief Removes all geometries from the cache. Geometries that are still in use are not affected. */
+            void clear();
+
+            /*! \brief Returns true, if both values are equal after quantization. */
+            static bool equal(const float a, const float b);
+
+            /// The resolution of the geometry parameters.
+            static constexpr float quantum = 1.e-5f;
+
+            /// Once the cache holds this many geometries, new geometries are not cached anymore.
+            static constexpr std::size_t maxSize = 1024;
+
+         private:
+            /*-----------------------------------------
+             * PRIVATE METHODS
+             *---------------------------------------*/
+
+            struct Key
+            {
+                ShapeType type;
+                std::array<long, 4> params;
+
+                bool operator==(const Key& rhs) const
+                {
+                    return type == rhs.type && params == rhs.params;
+                }
+            };
+
+            struct KeyHash
+            {
+                std::size_t operator()(const Key& key) const;
+            };
+
+            static Key makeKey(const ShapeType type, const float p0, const float p1, const float p2, const float p3);
+
+            /*! \brief Inserts the geometry, if the cache is not full, and returns it. */
+            osg::Geometry* insert(const Key& key, osg::Geometry* geometry);
+
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            std::unordered_map<Key, osg::ref_ptr<osg::Geometry>, KeyHash> _geometries;
+        };
+
+    }  // namespace Model
+}  // namespace OMVIS
+
+#endif /* INCLUDE_GEOMETRYCACHE_HPP_ */
+/**
+ * \}
+ */
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Model
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_MATPREFETCHER_HPP_
+#define INCLUDE_MATPREFETCHER_HPP_
+
+#include "Model/MatResultFile.hpp"
+#include "Model/BakedTransforms.hpp"
+#include "Model/ShapeObject.hpp"
+#include "Model/ShapeTable.hpp"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*! \brief One prefetched frame in the ring of a \ref MatPrefetcher. */
+        struct PrefetchedFrame
+        {
+            //! The visualization time of the frame.
+            double time;
+            //! The playback generation the frame has been computed for.
+            unsigned int generation;
+            //! Final matrix, colour and size of every shape.
+            std::vector<BakedShape> shapes;
+        };
+
+        /*! \brief Computes upcoming frames of a MAT file based visualization on a background thread.
+         *
+         * The prefetcher owns a copy of the shapes and binds the dynamic attributes of its own \ref ShapeTable to the
+         * result file. A producer thread interpolates the attributes and computes the transformations of the frames
+         * t, t + h, t + 2h, ... in advance and pushes them into a single producer single consumer ring buffer. The
+         * step h may be negative for reverse playback. The GUI thread only pops the frame matching its current
+         * visualization time and copies it into the shapes of the scene.
+         *
+         * Whenever the playback is interrupted, e.g., by the time slider or a new speedup, the requested time does not
+         * match the prefetched frames. Then the caller computes the frame on its own and calls \ref restart, which
+         * invalidates all frames in the ring by increasing the playback generation.
+         *
+         * The ring itself is lock-free. The mutex and condition variable are only used to put the producer to sleep
+         * while the ring is full or there is nothing to do.
+         *
+         * \remark The result file has to stay open and unchanged as long as the prefetcher exists. The producer only
+         *         uses the const methods of \ref MatResultFile with its own \ref MatCursor.
+         */
+        class MatPrefetcher
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            MatPrefetcher() = delete;
+
+            /*! \brief Creates the prefetcher and starts the producer thread.
+             *
+             * The producer is idle until \ref restart is called the first time.
+             *
+             * \param matFile   The opened result file.
+             * \param shapes    The shapes to compute the frames for. They are copied.
+             */
+            MatPrefetcher(const MatResultFile& matFile, const std::vector<ShapeObject>& shapes);
+
+            /*! \brief Stops and joins the producer thread. */
+            ~MatPrefetcher();
+
+            MatPrefetcher(const MatPrefetcher& rhs) = delete;
+
+            MatPrefetcher& operator=(const MatPrefetcher& rhs) = delete;
+
+            /*-----------------------------------------
+             * GETTERS and SETTERS
+             *---------------------------------------*/
+
+            /*! \brief Returns the number of frames in the ring, including frames of a former playback generation.
+             *
+             * Must only be called by the consumer, i.e., the thread calling \ref pop and \ref restart.
+             */
+            std::size_t getNumFrames() const;
+
+            /*-----------------------------------------
+             * SIMULATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Discards all prefetched frames and starts prefetching at the given time.
+             *
+             * \param time  The visualization time of the next frame.
+             * \param step  The visualization step size. Negative values mean reverse playback.
+             */
+            void restart(const double time, const double step);
+
+            /*! \brief Takes the frame of the given time from the ring and copies it into the shapes.
+             *
+             * Frames for earlier times in playback direction or of a former playback generation are dropped. Frames
+             * for later times stay in the ring.
+             *
+             * \param time      The visualization time.
+             * \param shapes    The shapes of the scene, in the same order as passed to the constructor.
+             * \param table     The shape table of the scene. The changed shapes are marked as dirty.
+             * \return True, if the frame has been prefetched. Otherwise, the shapes are unchanged.
+             */
+            bool pop(const double time, std::vector<ShapeObject>& shapes, ShapeTable& table);
+
+         private:
+            /*-----------------------------------------
+             * PRIVATE METHODS
+             *---------------------------------------*/
+
+            /*! \brief The loop of the producer thread. */
+            void run();
+
+            /*! \brief Computes the frame of the given time into the given slot of the ring. */
+            void computeFrame(const double time, PrefetchedFrame& frame);
+
+            /*! \brief Returns true, if the ring has no free slot. */
+            bool isFull() const;
+
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            //! Number of frames that are computed in advance.
+            static constexpr std::size_t ringSize = 16;
+
+            const MatResultFile& _matFile;
+            //! Copy of the shapes the producer works on.
+            std::vector<ShapeObject> _shapes;
+            //! The attributes of \a _shapes and the columns of their variables.
+            ShapeTable _table;
+            MatColumnBatch _batch;
+            //! The producer's position on the time axis of the result file.
+            MatCursor _cursor;
+
+            std::array<PrefetchedFrame, ringSize> _ring;
+            //! Number of frames popped so far. Only written by the consumer.
+            std::atomic<std::size_t> _head;
+            //! Number of frames pushed so far. Only written by the producer.
+            std::atomic<std::size_t> _tail;
+            //! Increased by every call of \ref restart.
+            std::atomic<unsigned int> _generation;
+
+            //! Protects \a _nextTime, \a _step and \a _stop. They are only written with the mutex held.
+            std::mutex _mutex;
+            std::condition_variable _wakeUp;
+            double _nextTime;
+            double _step;
+            bool _stop;
+
+            std::thread _thread;
+        };
+
+    }  // namespace Model
+}  // namespace OMVIS
+
+#endif /* INCLUDE_MATPREFETCHER_HPP_ */
+/**
+ * \}
+ */
@@ -0,0 +1,355 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Model
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_MATRESULTFILE_HPP_
+#define INCLUDE_MATRESULTFILE_HPP_
+
+#include "Util/MappedFile.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*! \brief A strided view on one variable of a memory-mapped MAT file.
+         *
+         * The column does not own any data. It points directly into the mapped \a data_1 or \a data_2 block of the
+         * result file. Parameters (\a data_1) have a row stride of 0, thus every row yields the same value.
+         */
+        struct MatColumn
+        {
+            /*! \brief Returns the value of the variable in the given row of the data block. */
+            double at(const std::size_t row) const
+            {
+                const char* ptr = base + row * rowStride;
+                if (isDouble)
+                {
+                    double val;
+                    std::memcpy(&val, ptr, sizeof(double));
+                    return sign * val;
+                }
+                float val;
+                std::memcpy(&val, ptr, sizeof(float));
+                return sign * static_cast<double>(val);
+            }
+
+            //! Address of the value in the first row.
+            const char* base;
+            //! Distance in bytes between two consecutive rows.
+            std::size_t rowStride;
+            //! -1.0 for negated alias variables, 1.0 otherwise.
+            double sign;
+            //! True, if the values are stored in double precision, false for single precision.
+            bool isDouble;
+        };
+
+        /*! \brief A position on the time axis of a MAT file, see \ref MatResultFile::seek. */
+        struct MatCursor
+        {
+            //! Lower of the two rows bracketing the time.
+            std::size_t row;
+            //! Interpolation weight of the row \a row + 1.
+            double weight;
+        };
+
+        /*! \brief A set of columns that is interpolated at once by \ref MatResultFile::interpolate.
+         *
+         * The columns are stored as structure of arrays, i.e., addresses of the first rows, row masks and signs. This
+         * allows the interpolation kernel to process four columns per AVX2 gather.
+         */
+        class MatColumnBatch
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            MatColumnBatch();
+
+            ~MatColumnBatch() = default;
+
+            MatColumnBatch(const MatColumnBatch& rhs) = delete;
+
+            MatColumnBatch& operator=(const MatColumnBatch& rhs) = delete;
+
+            /*-----------------------------------------
+             * GETTERS and SETTERS
+             *---------------------------------------*/
+
+            /*! \brief Removes all columns from the batch. */
+            void clear();
+
+            /*! \brief Returns the number of columns in the batch. */
+            std::size_t size() const;
+
+         private:
+            friend class MatResultFile;
+
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            //! Address of the first row of each column.
+            std::vector<std::int64_t> _addresses;
+            //! All bits set for time dependent variables, zero for parameters which have no row stride.
+            std::vector<std::int64_t> _rowMasks;
+            //! -1.0 for negated alias variables, 1.0 otherwise.
+            std::vector<double> _signs;
+            //! Per column: 1, if the values are stored in double precision.
+            std::vector<unsigned char> _isDouble;
+            //! True, if all columns are stored in double precision. Only then the AVX2 kernel is used.
+            bool _allDouble;
+        };
+
+        /*! \brief Memory-mapped reader for OpenModelica result files in MAT v4 format.
+         *
+         * In contrast to ModelicaMatReader, the file is not read into the heap. The \a data_2 block is mapped into
+         * memory and every variable is exposed as a zero-copy \ref MatColumn. The reader keeps a playback cursor on
+         * the time axis. Since consecutive frames request neighboring times, the cursor is moved incrementally and
+         * the bracketing time rows are found in O(1) during playback. Only large jumps, e.g., from the time slider,
+         * fall back to a binary search.
+         *
+         * Usage: Call \ref seek once per frame and afterwards \ref getValue for all variables of interest. Threads
+         * that read the same file concurrently use their own \ref MatCursor with the const overloads of \ref seek
+         * and \ref interpolate.
+         *
+         * Result files of large models carry tens of thousands of variables of which only a few are visualized. For
+         * these, the file can be opened selectively. Only the \a data_2 columns of the requested variables, including
+         * the targets of (negated) aliases, are decoded into a compact row major table. The mapped pages of \a data_2
+         * are released while decoding. Thus, memory consumption and open time scale with the visualized variables
+         * and not with the size of the model.
+         */
+        class MatResultFile
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            MatResultFile();
+
+            ~MatResultFile();
+
+            MatResultFile(const MatResultFile& rhs) = delete;
+
+            MatResultFile& operator=(const MatResultFile& rhs) = delete;
+
+            /*-----------------------------------------
+             * INITIALIZATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Maps the given MAT file into memory and parses its header matrices.
+             *
+             * If another file is already open, it is closed first.
+             *
+             * \param fileName  Absolute path to the MAT file.
+             * \throws std::runtime_error if the file cannot be mapped or is not a valid OpenModelica result file.
+             */
+            void open(const std::string& fileName);
+
+            /*! \brief Maps the given MAT file into memory and decodes only the given variables.
+             *
+             * Afterwards, \ref findVariable finds the given variables only. Parameters are still read from the
+             * mapped \a data_1 block.
+             *
+             * \param fileName  Absolute path to the MAT file.
+             * \param varNames  Names of the variables to load.
+             * \throws std::runtime_error if the file cannot be mapped or is not a valid OpenModelica result file.
+             */
+            void open(const std::string& fileName, const std::vector<std::string>& varNames);
+
+            /*! \brief Unmaps the file. */
+            void close();
+
+            /*-----------------------------------------
+             * GETTERS and SETTERS
+             *---------------------------------------*/
+
+            /*! \brief Returns true, if a file is mapped. */
+            bool isOpen() const;
+
+            /*! \brief Looks up the variable with the given name.
+             *
+             * \param varName   Name of the variable, e.g., world.x_label.R.T[1,1].
+             * \param column    The resulting column view. Unchanged, if the variable does not exist.
+             * \return True, if the variable has been found.
+             */
+            bool findVariable(const std::string& varName, MatColumn& column) const;
+
+            /*! \brief Returns the number of stored output time points. */
+            std::size_t getNumRows() const;
+
+            /*! \brief Returns the number of mapped ranges of data_2, which have been released after decoding. */
+            std::size_t getNumReleasedRanges() const;
+
+            /*! \brief Returns the first time value of the result. */
+            double getStartTime() const;
+
+            /*! \brief Returns the last time value of the result. */
+            double getStopTime() const;
+
+            /*! \brief Returns the time value of the given row. */
+            double getTime(const std::size_t row) const;
+
+            /*-----------------------------------------
+             * SIMULATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Moves the playback cursor to the given time.
+             *
+             * The cursor is moved row by row from its current position, which is O(1) for playback in forward or
+             * backward direction. For larger distances a binary search is used. Times outside of the result are
+             * clamped to the first or last row.
+             *
+             * \param time  The time to move the cursor to.
+             */
+            void seek(const double time);
+
+            /*! \brief Moves the given cursor to the given time. See \ref seek(const double). */
+            void seek(const double time, MatCursor& cursor) const;
+
+            /*! \brief Moves the playback cursor exactly onto the given row. */
+            void seekRow(const std::size_t row);
+
+            /*! \brief Returns the lower of the two rows bracketing the current cursor time. */
+            std::size_t getCursorRow() const;
+
+            /*! \brief Returns the interpolation weight of the upper bracketing row at the current cursor time. */
+            double getCursorWeight() const;
+
+            /*! \brief Appends the given column to the batch.
+             *
+             * \remark The column has to be found by \ref findVariable of this object.
+             */
+            void addToBatch(const MatColumn& column, MatColumnBatch& batch) const;
+
+            /*! \brief Interpolates all columns of the batch at the current cursor time.
+             *
+             * The bracketing rows and the weight are determined once by \ref seek. If OMVIS is compiled with AVX2
+             * support, four columns are gathered and interpolated per instruction, the remainder is done in a scalar
+             * loop.
+             *
+             * \param batch   The columns to interpolate.
+             * \param values  Flat output array with at least batch.size() elements.
+             */
+            void interpolate(const MatColumnBatch& batch, float* values) const;
+
+            /*! \brief Interpolates all columns of the batch at the time of the given cursor. */
+            void interpolate(const MatColumnBatch& batch, const MatCursor& cursor, float* values) const;
+
+            /*! \brief Returns the linearly interpolated value of the given column at the current cursor time. */
+            double getValue(const MatColumn& column) const
+            {
+                const double lo = column.at(_cursor.row);
+                if (0.0 == _cursor.weight)
+                    return lo;
+                return lo + _cursor.weight * (column.at(_cursor.row + 1) - lo);
+            }
+
+         private:
+            /*-----------------------------------------
+             * PRIVATE METHODS
+             *---------------------------------------*/
+
+            /*! \brief Maps the file into memory. */
+            void mapFile(const std::string& fileName);
+
+            /*! \brief Walks through the matrices of the file and indexes names, dataInfo, data_1 and data_2.
+             *
+             * \param varNames  If not nullptr, only the names in this set are indexed.
+             */
+            void parseMatrices(const std::unordered_set<std::string>* varNames);
+
+            /*! \brief Decodes the data_2 columns of all indexed variables into \a _selectedRows. */
+            void loadSelectedColumns();
+
+            /*! \brief Returns the lower bracketing row of time by binary search. */
+            std::size_t searchRow(const double time) const;
+
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            //! Name of the mapped file.
+            std::string _fileName;
+            //! The mapping of the file.
+            Util::MappedFile _file;
+            //! Start address and size of \a _file, which are used by the hot path.
+            const char* _data;
+            std::size_t _size;
+
+            //! Maps variable names to their index in dataInfo.
+            std::unordered_map<std::string, std::size_t> _varIndices;
+            //! Start of the dataInfo matrix (4 x nVars, int32).
+            const char* _dataInfo;
+            //! Distance in values between two variables and between two fields of one variable in dataInfo.
+            std::size_t _infoVarStride;
+            std::size_t _infoFieldStride;
+
+            //! Start of data_1 and data_2.
+            const char* _data1;
+            const char* _data2;
+            //! Size of a value in data_1 and data_2 in bytes (4 or 8).
+            std::size_t _data1ValueSize;
+            std::size_t _data2ValueSize;
+            //! Distance in values between two variables of the same row (1 for transposed storage).
+            std::size_t _data1VarStride;
+            std::size_t _data2VarStride;
+            //! Distance in values between two rows of the same variable.
+            std::size_t _data2RowStride;
+            //! Distance in bytes between two rows of the time dependent columns returned by \ref findVariable.
+            std::size_t _rowBytes;
+            //! Row major table of the selected data_2 columns. Empty, if the file is not opened selectively.
+            std::vector<double> _selectedRows;
+            //! Maps a data_2 column to its position in a row of \a _selectedRows.
+            std::unordered_map<std::size_t, std::size_t> _selectedColumns;
+            //! Number of variables in data_1 and data_2.
+            std::size_t _numParams;
+            std::size_t _numVars;
+            //! Number of time points in data_2.
+            std::size_t _numRows;
+
+            //! The time column, i.e., the first variable of data_2.
+            MatColumn _time;
+            //! The playback cursor.
+            MatCursor _cursor;
+        };
+
+    }  // namespace Model
+}  // namespace OMVIS
+
+#endif /* INCLUDE_MATRESULTFILE_HPP_ */
+/**
+ * \}
+ */
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Model
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_NODEUPDATER_HPP_
+#define INCLUDE_NODEUPDATER_HPP_
+
+#include "Model/ShapeObject.hpp"
+#include "Model/GeometryCache.hpp"
+#include "Model/OSGScene.hpp"
+
+#include <vector>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*! \brief Writes the state of a shape to its nodes in the scene graph.
+         *
+         * The nodes are accessed through the handles returned by \ref OSGScene::setUpScene. Thus, there is no
+         * traversal of the scene graph and the shape is not copied.
+         */
+        class NodeUpdater
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            NodeUpdater();
+
+            ~NodeUpdater() = default;
+
+            NodeUpdater(const NodeUpdater& rhs) = delete;
+
+            NodeUpdater& operator=(const NodeUpdater& rhs) = delete;
+
+            /*-----------------------------------------
+             * SIMULATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Updates the matrix, the geometry and the material of the shape.
+             *
+             * Dispatches once on the \ref ShapeType of the shape to the geometry update of the respective type. For
+             * instanced shapes, only the matrix and the color are written to their \ref InstancedPrimitive.
+             *
+             * \param nodes     The handles of the nodes of the shape. The drawable is updated, if it is replaced.
+             * \param shape     The shape.
+             */
+            void update(ShapeNodes& nodes, const ShapeObject& shape);
+
+            /*! \brief Marks the instanced primitives changed by \ref update since the last call as modified, such
+             *         that their per-instance arrays are uploaded once per frame. Called after the last shape of a
+             *         frame has been updated.
+             */
+            void finishFrame();
+
+         private:
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            /// The generated geometries of pipes and springs.
+            GeometryCache _geometryCache;
+            /// The instanced primitives with instances changed since the last \ref finishFrame.
+            std::vector<InstancedPrimitive*> _changedInstances;
+        };
+
+    }  // namespace Model
+}  // namespace OMVIS
+
+#endif /* INCLUDE_NODEUPDATER_HPP_ */
+/**
+ * \}
+ */
@@ -28,17 +28,44 @@
 #define INCLUDE_OSGSCENE_HPP_
 
 #include "Model/ShapeObject.hpp"
+#include "Model/Shapes/InstancedPrimitive.hpp"
 
 #include <rapidxml.hpp>
 #include <osg/Group>
+#include <osg/Geode>
+#include <osg/Material>
+#include <osg/MatrixTransform>
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace OMVIS
 {
     namespace Model
     {
 
+        /*! \brief Handles of the nodes of one shape in the scene graph.
+         *
+         * The nodes are owned by the scene graph. A handle is nullptr, if the shape does not have such a node, e.g.,
+         * CAD files do not have a material and STL files do not have a single geode. Constant shapes are merged into
+         * the static part of the scene, thus all their handles are nullptr. Instanced shapes only have a slot in
+         * their \ref InstancedPrimitive.
+         */
+        struct ShapeNodes
+        {
+            osg::MatrixTransform* transform;
+            osg::Geode* geode;
+            //! The first drawable of \a geode.
+            osg::Drawable* drawable;
+            osg::Material* material;
+            //! The primitive drawing this shape, if it is instanced.
+            InstancedPrimitive* instances;
+            //! The instance of this shape in \a instances.
+            std::uint32_t instance;
+        };
+
         /*! \brief Class that stores the pointer to the root node of the models OSG scene.
          *
          * \todo This class handles access to the root node. Encapsulate access to the pointer.
@@ -62,8 +89,20 @@ namespace OMVIS
              * INITIALIZATION METHODS
              *---------------------------------------*/
 
-            /*! \brief Sets up all nodes initially. */
-            void setUpScene(const std::vector<Model::ShapeObject>& allShapes);
+            /*! \brief Sets up all nodes initially.
+             *
+             * Every non-constant shape gets its own transformation, geode and material. The constant shapes never
+             * change, thus they are baked into one static subgraph, see \ref createStaticScene. If there are at least
+             * \a minInstances non-constant boxes, cylinders, cones or spheres, all shapes of this type are drawn by one
+             * \ref InstancedPrimitive instead, i.e., with one draw call.
+             *
+             * \param allShapes     The shapes of the scene.
+             * \param constShapes   Indices of the shapes whose attributes are all constant, see
+             *                      \ref ShapeTable::getConstShapes. Their matrices have to be computed already.
+             * \return The handles of the nodes of every shape, in the order of \a allShapes.
+             */
+            std::vector<ShapeNodes> setUpScene(const std::vector<Model::ShapeObject>& allShapes,
+                                               const std::vector<std::uint32_t>& constShapes);
 
             /*-----------------------------------------
              * SETTERS AND GETTERS
@@ -78,7 +117,25 @@ namespace OMVIS
             /*! \brief Set path to the scene file. */
             void setPath(const std::string& path);
 
+            /*! \brief Minimal number of shapes of a primitive type, which are drawn instanced. */
+            static constexpr std::size_t minInstances = 16;
+
          private:
+            /*-----------------------------------------
+             * PRIVATE METHODS
+             *---------------------------------------*/
+
+            /*! \brief Creates the subgraph of the constant shapes.
+             *
+             * The nodes of the shapes are run through the osgUtil::Optimizer, which moves their matrices into the
+             * vertices and merges primitives of the same state into one geometry. The primitives carry their color as
+             * vertex color, thus they all share one state. osg::convertShapeToGeometry is available since OSG 3.5.6,
+             * the development version leading to 3.6. With older versions, the primitives are shape drawables, which
+             * cannot be flattened. They keep their static transformation instead.
+             */
+            osg::ref_ptr<osg::Group> createStaticScene(const std::vector<Model::ShapeObject>& allShapes,
+                                                       const std::vector<std::uint32_t>& constShapes) const;
+
             /*-----------------------------------------
              * MEMBERS
              *---------------------------------------*/
@@ -21,6 +21,7 @@
 #define INCLUDE_SHAPEOBJECT_HPP_
 
 #include "Model/ShapeObjectAttribute.hpp"
+#include "Model/ShapeType.hpp"
 
 #include <read_matlab4.h>
 #include <rapidxml.hpp>
@@ -29,6 +30,7 @@
 #include <osg/Matrix>
 #include <osg/Uniform>
 
+#include <array>
 
 namespace OMVIS
 {
@@ -54,6 +56,19 @@ namespace OMVIS
 
             ShapeObject& operator=(const ShapeObject&) = default;
 
+            /*-----------------------------------------
+             * GETTERS AND SETTERS
+             *---------------------------------------*/
+
+            /// Number of visualization attributes of a shape, i.e., the size of the array returned by getAttributes().
+            static constexpr std::size_t numAttributes = 29;
+
+            /*! \brief Returns pointers to all visualization attributes of this shape.
+             *
+             * The order is length, width, height, lDir, wDir, r, rShape, T, color, specCoeff and extra.
+             */
+            std::array<ShapeObjectAttribute*, numAttributes> getAttributes();
+
             /*-----------------------------------------
              * PRINT METHODS
              *---------------------------------------*/
@@ -68,6 +83,8 @@ namespace OMVIS
 
             std::string _id;
             std::string _type;
+            /*! The type resolved from \a _type by \ref getShapeTypeForString. */
+            ShapeType _shapeType;
 			std::string _fileName;
             ShapeObjectAttribute _length;
             ShapeObjectAttribute _width;
@@ -61,7 +61,7 @@ namespace OMVIS
             //if true, check the exp, if wrong check the cref
             bool isConst;
             float exp;
-            std::string cref; 			///< Only for MAT and CSV (future)
+            std::string cref; 			///< Only for MAT and CSV
             fmi1_value_reference_t fmuValueRef; ///< For (all) FMI versions
         };
 
@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Model
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_SHAPETABLE_HPP_
+#define INCLUDE_SHAPETABLE_HPP_
+
+#include "Model/ShapeObject.hpp"
+#include "Util/TransformKernel.hpp"
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*! \brief Index of a shape attribute in \ref ShapeObject::getAttributes and in a \ref ShapeTable.
+         *
+         * Vector valued attributes occupy consecutive indices, e.g., the y component of lDir is SA_LDIR + 1.
+         */
+        enum ShapeAttribute : std::size_t
+        {
+            SA_LENGTH = 0,
+            SA_WIDTH = 1,
+            SA_HEIGHT = 2,
+            SA_LDIR = 3,
+            SA_WDIR = 6,
+            SA_R = 9,
+            SA_RSHAPE = 12,
+            SA_T = 15,
+            SA_COLOR = 24,
+            SA_SPECCOEFF = 27,
+            SA_EXTRA = 28
+        };
+
+        /*! \brief Structure of arrays view on the attributes of all shapes of a scene.
+         *
+         * The values of one attribute of all shapes are stored contiguously, i.e., the values are attribute-major. A
+         * bitset per shape marks its constant attributes. The constant values are stored once when the table is built.
+         *
+         * The non-constant attributes are collected in the dynamic arrays, which are all in the same order. Many of
+         * them share a variable, e.g., a body and its cylinder reference the same frame. Thus, the distinct crefs are
+         * collected in the variable table and every dynamic attribute only stores the index of its variable.
+         *
+         * Each visualizer resolves the variables once to its own binding array (MAT columns, CSV columns, FMU value
+         * references) in the order of the variable table. Per frame, it fetches every variable exactly once into
+         * \ref getVariableValues and calls \ref scatter, which fans the values out to the dynamic attributes. Thus,
+         * the per-frame loop never touches a constant attribute.
+         *
+         * Besides the attributes, the table stores the transformation coefficients of every shape type and the
+         * transformation matrices of the current frame, which are computed by \ref Util::transformBatch.
+         *
+         * Every shape has a dirty flag, which is set by \ref scatter, if one of its attributes has changed. The flags
+         * of all shapes are set when the table is built. The shapes whose attributes are all constant are listed by
+         * \ref getConstShapes, all others by \ref getDynamicShapes.
+         *
+         * \remark The table keeps pointers into the shapes it has been built from. The vector of shapes must not be
+         *         reallocated as long as the table is used.
+         */
+        class ShapeTable
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            ShapeTable();
+
+            ~ShapeTable() = default;
+
+            ShapeTable(const ShapeTable& rhs) = delete;
+
+            ShapeTable& operator=(const ShapeTable& rhs) = delete;
+
+            /*-----------------------------------------
+             * INITIALIZATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Fills the table from the given shapes.
+             *
+             * \param shapes    The shapes. The dynamic attributes are written back to them by \ref scatter.
+             */
+            void build(std::vector<ShapeObject>& shapes);
+
+            /*! \brief Empties the table. */
+            void clear();
+
+            /*! \brief Turns all attributes referencing the given variables into constant ones with the given value.
+             *
+             * This is used for variables that cannot be resolved by the visualizer. They are removed from the variable
+             * table and their attributes from the dynamic arrays. The order of the remaining variables is preserved.
+             *
+             * \param varIndices    Indices into the variable table in ascending order.
+             * \param value         The constant value of the attributes.
+             */
+            void makeConst(const std::vector<std::size_t>& varIndices, const float value);
+
+            /*-----------------------------------------
+             * GETTERS and SETTERS
+             *---------------------------------------*/
+
+            /*! \brief Returns the number of shapes. */
+            std::size_t getNumShapes() const;
+
+            /*! \brief Returns the number of non-constant attributes of all shapes. */
+            std::size_t getNumDynamic() const;
+
+            /*! \brief Returns the number of distinct variables referenced by the dynamic attributes. */
+            std::size_t getNumVariables() const;
+
+            /*! \brief Returns the cref of the given variable. */
+            const std::string& getVariable(const std::size_t varIdx) const;
+
+            /*! \brief Returns the input array of \ref scatter with \ref getNumVariables elements. */
+            float* getVariableValues();
+
+            /*! \brief Returns the values of the given attribute of all shapes. The array has \ref getNumShapes
+             *         elements.
+             */
+            const float* getValues(const std::size_t attrIdx) const;
+
+            /*! \brief Returns the attribute arrays as input of \ref Util::transformBatch. */
+            Util::TransformInputs getTransformInputs() const;
+
+            /*! \brief Returns the transformation matrices, 16 values per shape in the layout of osg::Matrixd. */
+            double* getMatrices();
+
+            /*! \brief Returns true, if the given attribute of the given shape is constant. */
+            bool isConst(const std::size_t shapeIdx, const std::size_t attrIdx) const;
+
+            /*! \brief Returns true, if all attributes of the given shape are constant. */
+            bool isConstShape(const std::size_t shapeIdx) const;
+
+            /*! \brief Returns the indices of the shapes whose attributes are all constant. */
+            const std::vector<std::uint32_t>& getConstShapes() const;
+
+            /*! \brief Returns the indices of the shapes with at least one non-constant attribute. */
+            const std::vector<std::uint32_t>& getDynamicShapes() const;
+
+            /*! \brief Returns true, if an attribute of the given shape has changed since the last \ref clearDirty. */
+            bool isDirty(const std::size_t shapeIdx) const;
+
+            /*! \brief Marks the given shape as changed, e.g., if its attributes are not set by \ref scatter. */
+            void setDirty(const std::size_t shapeIdx);
+
+            /*! \brief Resets the dirty flags of all shapes. */
+            void clearDirty();
+
+            /*-----------------------------------------
+             * SIMULATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Copies the variable values of the current frame to all dynamic attributes, i.e., into the value
+             *         arrays and the shapes. The shapes with changed attributes are marked as dirty.
+             */
+            void scatter();
+
+            /*! \brief Forces the next \ref scatter to treat all dynamic attributes as changed.
+             *
+             * This has to be called, if the shapes have been changed without the table, e.g., by a prefetched frame.
+             */
+            void invalidateValues();
+
+         private:
+            /*-----------------------------------------
+             * PRIVATE METHODS
+             *---------------------------------------*/
+
+            /*! \brief Sorts the shapes into \a _constShapes and \a _dynamicShapes. */
+            void collectShapes();
+
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            std::size_t _numShapes;
+            //! Attribute-major values, i.e., _values[attrIdx * _numShapes + shapeIdx].
+            std::vector<float> _values;
+            //! Coefficient-major transformation coefficients, i.e., _coefficients[coeffIdx * _numShapes + shapeIdx].
+            std::vector<float> _coefficients;
+            //! Transformation matrices of the current frame.
+            std::vector<double> _matrices;
+            //! Constant attributes per shape.
+            std::vector<std::bitset<ShapeObject::numAttributes>> _constMasks;
+
+            //! Position of every dynamic attribute in \a _values.
+            std::vector<std::uint32_t> _dynamicSlots;
+            //! The dynamic attributes in the shapes.
+            std::vector<ShapeObjectAttribute*> _dynamicAttrs;
+            //! Position of the variable of every dynamic attribute in \a _variables.
+            std::vector<std::uint32_t> _dynamicVariables;
+            //! Shape of every dynamic attribute.
+            std::vector<std::uint32_t> _dynamicShapeIndices;
+
+            //! Shapes whose attributes are all constant.
+            std::vector<std::uint32_t> _constShapes;
+            //! Shapes with at least one non-constant attribute.
+            std::vector<std::uint32_t> _dynamicShapes;
+            //! One flag per shape, 1 if the shape has changed.
+            std::vector<std::uint8_t> _dirty;
+
+            //! The distinct crefs of the dynamic attributes in order of their first occurrence.
+            std::vector<std::string> _variables;
+            //! The values of \a _variables at the current frame, filled by the visualizer.
+            std::vector<float> _variableValues;
+        };
+
+    }  // namespace Model
+}  // namespace OMVIS
+
+#endif /* INCLUDE_SHAPETABLE_HPP_ */
+/**
+ * \}
+ */
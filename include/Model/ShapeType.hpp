@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Model
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_SHAPETYPE_HPP_
+#define INCLUDE_SHAPETYPE_HPP_
+
+#include <string>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*! \brief The kinds of shapes OMVIS can display.
+         *
+         * The type string of a shape is resolved once when the visual XML file is loaded. Everything that depends on
+         * the type, e.g., the scene setup, the transformation and the per-frame update of the nodes, switches on this
+         * enum instead of comparing strings.
+         */
+        enum class ShapeType
+        {
+            BOX = 0,
+            CYLINDER = 1,
+            CONE = 2,
+            SPHERE = 3,
+            PIPE = 4,
+            PIPECYLINDER = 5,
+            SPRING = 6,
+            STL = 7,           ///< CAD file read by osgDB.
+            DXF = 8,           ///< CAD file read by \ref DXFile.
+            CAD = 9,           ///< Any other CAD file, i.e., a type of the form "modelica://...".
+            UNKNOWN = 10       ///< Displayed as capsule.
+        };
+
+        /*-----------------------------------------
+         * FREE METHODS
+         *---------------------------------------*/
+
+        /*! \brief Returns the shape type for the given type string.
+         *
+         * \param typeString    The type of the shape, i.e., "box", "stl", "modelica://..." etc.
+         */
+        ShapeType getShapeTypeForString(const std::string& typeString);
+
+    }  // namespace Model
+}  // namespace OMVIS
+
+#endif /* INCLUDE_SHAPETYPE_HPP_ */
+/**
+ * \}
+ */
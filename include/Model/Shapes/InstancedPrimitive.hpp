@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Model
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_INSTANCEDPRIMITIVE_HPP_
+#define INCLUDE_INSTANCEDPRIMITIVE_HPP_
+
+#include "Model/ShapeType.hpp"
+
+#include <osg/Geometry>
+#include <osg/Matrixd>
+
+#include <cstddef>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*! \brief A primitive at unit size, which is drawn once per shape with a single instanced draw call.
+         *
+         * The shapes of one primitive type (box, cylinder, cone or sphere) share one instance of this class. The
+         * matrix and the color of every shape are stored in four per-instance vertex attributes with divisor 1,
+         * starting at \a firstAttribute. Attribute k holds row k of the matrix in xyz and the k-th color component
+         * in w, i.e., the translation comes with the alpha value. A vertex shader applies the matrix and lights the
+         * primitive by the first light source and the current material, whose diffuse color is replaced by the color
+         * of the instance.
+         *
+         * Only GLSL 1.20 and instanced arrays (OpenGL 3.3 or ARB_instanced_arrays) are required. Thus, the path also
+         * works with the software rasterizers of Mesa.
+         *
+         * The geometry has data variance DYNAMIC, since the per-instance arrays are changed every frame.
+         */
+        class InstancedPrimitive : public osg::Geometry
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            /*! \brief Creates the geometry of the given primitive type at unit size, see \ref OSGScene::setUpScene.
+             *
+             * \param type          The primitive type, i.e., box, cylinder, cone or sphere.
+             * \param numInstances  The number of shapes drawn by this primitive.
+             */
+            InstancedPrimitive(const ShapeType type, const std::size_t numInstances);
+
+            ~InstancedPrimitive() = default;
+
+            /*-----------------------------------------
+             * GETTERS AND SETTERS
+             *---------------------------------------*/
+
+            /*! \brief Returns true, if shapes of the given type can be drawn by this class. */
+            static bool isInstanced(const ShapeType type);
+
+            std::size_t getNumInstances() const;
+
+            /*! \brief Sets the matrix and the color of the given instance.
+             *
+             * The change is not visible before \ref dirtyInstances is called, which should happen once after the last
+             * instance of a frame has been set.
+             */
+            void setInstance(const std::size_t instance, const osg::Matrixd& mat, const osg::Vec4f& color);
+
+            /*! \brief Marks the per-instance arrays and the bound as modified. The arrays are uploaded with the next
+             *         draw.
+             */
+            void dirtyInstances();
+
+            /*! \brief Returns the bounding box of all instances. */
+            virtual osg::BoundingBox computeBoundingBox() const override;
+
+            /*! \brief Index of the first per-instance vertex attribute. */
+            static constexpr unsigned int firstAttribute = 10;
+
+         private:
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            std::size_t _numInstances;
+            //! Bounding box of the primitive at unit size.
+            osg::BoundingBox _unitBound;
+            //! The per-instance arrays, see the class description.
+            osg::ref_ptr<osg::Vec4Array> _instanceData[4];
+        };
+
+    }  // namespace Model
+}  // namespace OMVIS
+
+#endif /* INCLUDE_INSTANCEDPRIMITIVE_HPP_ */
+/**
+ * \}
+ */
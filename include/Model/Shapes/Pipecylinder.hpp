@@ -45,6 +45,31 @@ namespace OMVIS
 
             ~Pipecylinder() = default;
 
+            /*-----------------------------------------
+             * GETTERS AND SETTERS
+             *---------------------------------------*/
+
+            float getInnerRadius() const;
+
+            float getOuterRadius() const;
+
+            float getLength() const;
+
+            /*! \brief Moves the end rings to the given length. The vertex array is updated in place.
+             *
+             * \remark The geometry should have data variance DYNAMIC, if it is changed while it is displayed.
+             */
+            void setLength(const float l);
+
+         private:
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            float _rI;
+            float _rO;
+            float _l;
+            osg::ref_ptr<osg::Vec3Array> _vertices;
         };
 
     }  // namespace Model
@@ -47,7 +47,29 @@ namespace OMVIS
 
             ~Spring() = default;
 
+            /*-----------------------------------------
+             * GETTERS AND SETTERS
+             *---------------------------------------*/
+
+            float getRadius() const;
+
+            float getCoilRadius() const;
+
+            float getNumWindings() const;
+
+            float getLength() const;
+
+            /*! \brief Stretches the spring to the given length. The vertex arrays are updated in place, the facets are
+             *         kept.
+             *
+             * \remark The geometry should have data variance DYNAMIC, if it is changed while it is displayed.
+             */
+            void setLength(const float l);
+
          private:
+            /*! \brief Computes the spline and the facet vertices for the current parameters. */
+            void computeVertices();
+
             /*-----------------------------------------
              * MATH FUNCTIONS
              *---------------------------------------*/
@@ -66,6 +88,11 @@ namespace OMVIS
              * MEMBERS
              *---------------------------------------*/
 
+            float _r;
+            float _rCoil;
+            float _nWindings;
+            float _l;
+            int _numSegments;
             osg::ref_ptr<osg::Vec3Array> _outerVertices;
             osg::ref_ptr<osg::Vec3Array> _splineVertices;
         };
@@ -59,7 +59,8 @@ namespace OMVIS
          *
          * The user can specify the settings of a MAT result file based simulation via the \ref OMVIS::View::SimSettingDialog.
          * The user can specifically specify the speedup of the simulation, i.e., a speedup less than one will slow
-         * down the simulation, a speed up greater than one, will speed it up.
+         * down the simulation, a speed up greater than one, will speed it up. A negative speedup plays a MAT file
+         * result backwards.
          */
         struct UserSimSettingsMAT
         {
@@ -29,6 +29,7 @@
 
 #include "Util/Visualize.hpp"
 #include "Model/ShapeObject.hpp"
+#include "Model/ShapeTable.hpp"
 
 #include <rapidxml.hpp>
 
@@ -81,7 +82,9 @@ namespace OMVIS
             /*! \brief Clears the visual XML file. */
             void clearXMLDoc();
 
-            /*! \brief Gets all visual objects from the visual XML file and fills the vector of ShapeObject. */
+            /*! \brief Gets all visual objects from the visual XML file, fills the vector of ShapeObject and builds the
+             *         shape table from it.
+             */
             void initVisObjects();
 
             /*-----------------------------------------
@@ -123,6 +126,8 @@ namespace OMVIS
          public:
             /// Stores all visualization objects.
             std::vector<ShapeObject> _shapes;
+            /// Structure of arrays view on the attributes of \a _shapes. Built in \ref initVisObjects.
+            ShapeTable _shapeTable;
 
          private:
             /// Name (incl. path) of the XML file which holds necessary information for visualization.
@@ -33,7 +33,8 @@ namespace OMVIS
             FMU = 1,
             FMU_REMOTE = 2,
             MAT = 3,
-            MAT_REMOTE = 4
+            MAT_REMOTE = 4,
+            CSV = 5
         };
 
     }  // namespace Model
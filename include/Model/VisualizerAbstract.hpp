@@ -30,10 +30,12 @@
 #include <Model/OMVISScene.hpp>
 #include <Model/VisualBase.hpp>
 #include "Control/TimeManager.hpp"
-#include "Model/UpdateVisitor.hpp"
+#include "Model/NodeUpdater.hpp"
 #include "Model/VisualizationTypes.hpp"
 #include "Model/SimSettings.hpp"
 #include "Util/Visualize.hpp"
+#include "Util/ThreadPool.hpp"
+#include "Util/StageTimer.hpp"
 #include "ShapeObjectAttribute.hpp"
 
 #include <memory>
@@ -47,14 +49,18 @@ namespace OMVIS
          *
          * It provides basic methods for visualization.
          *
-         * Currently, there are three concrete implementations:
+         * Currently, there are four concrete implementations:
          *      - \ref VisualizerFMU for visualization of models encapsulated as FMU
          *      - \ref VisualizerMAT for visualization of simulation result files in MAT format
+         *      - \ref VisualizerCSV for visualization of simulation result files in CSV format
          *      - \ref VisualizerFMUClient for remote visualization of models encapsulated as FMU
          *
          * The VisualizerAbstract class holds a shared pointer to the Control::TimeManager object. Moreover, the
          * VisualizerAbstract constructs this TimeManager object and sets the default end time to 100.
          *
+         * Once the scene is set up, a frame, i.e., \ref sceneUpdate, does not allocate any memory on the heap. All
+         * buffers are sized during initialization and the log messages of a frame are only built, if they are written.
+         * Only pipes and springs whose radii change get new geometries, see \ref NodeUpdater.
          */
         class VisualizerAbstract
         {
@@ -112,6 +118,17 @@ namespace OMVIS
 
             std::string getModelFile() const;
 
+            /*! \brief Returns the number of shapes whose nodes have been updated by the last frame. */
+            std::size_t getNumUpdatedShapes() const;
+
+            /*! \brief Returns the number of shapes that have been skipped by the last frame, because they have not
+             *         changed.
+             */
+            std::size_t getNumSkippedShapes() const;
+
+            /*! \brief Returns the time the last frame has spent in each stage. */
+            const Util::FrameTimes& getFrameTimes() const;
+
             /*-----------------------------------------
              * SIMULATION METHODS
              *---------------------------------------*/
@@ -148,9 +165,23 @@ namespace OMVIS
             const VisType _visType;
             std::shared_ptr<VisualBase> _baseData;
             std::shared_ptr<OMVISScene> _viewerStuff;
-            std::shared_ptr<UpdateVisitor> _nodeUpdater;
+            std::shared_ptr<NodeUpdater> _nodeUpdater;
+            /** \brief The handles of the nodes of every shape, returned by \ref OSGScene::setUpScene. */
+            std::vector<ShapeNodes> _shapeNodes;
             std::shared_ptr<Control::TimeManager> _timeManager;
 
+            /** \brief Computes the per-shape part of a frame in parallel, see \ref computeTransforms. */
+            Util::ThreadPool _threadPool;
+
+            /** \brief Number of shapes a task of \a _threadPool processes at once. */
+            static constexpr std::size_t shapeGrainSize = 32;
+
+            std::size_t _numUpdatedShapes;
+            std::size_t _numSkippedShapes;
+
+            /** \brief The time of the last frame per stage. It is reset by \ref sceneUpdate. */
+            Util::FrameTimes _frameTimes;
+
             /*-----------------------------------------
              * PROTECTED METHODS
              *---------------------------------------*/
@@ -200,6 +231,23 @@ namespace OMVIS
              */
             virtual void updateScene(const double time) = 0;
 
+            /*! \brief Computes the transformation matrices of all shapes from their current attribute values.
+             *
+             * The matrices are computed from the shape table by the batched kernel \ref Util::transformBatch and copied
+             * into the shapes afterwards. The shapes do not depend on each other, thus they are distributed over the
+             * threads of \a _threadPool.
+             */
+            void computeTransforms();
+
+            /*! \brief Passes the current state of the changed shapes to their nodes in the scene graph.
+             *
+             * Only the shapes marked as dirty in the shape table are updated. The constant shapes are part of the
+             * static scene, see \ref OSGScene::setUpScene, and always skipped. The dirty flags are reset.
+             *
+             * This is the serial part of a frame. It has to be called from the GUI thread.
+             */
+            void updateSceneNodes();
+
         };
 
     }  // namespace Model
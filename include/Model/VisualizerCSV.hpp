@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Model
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_VISUALIZERCSV_HPP_
+#define INCLUDE_VISUALIZERCSV_HPP_
+
+#include "Model/VisualizerAbstract.hpp"
+#include "Model/CsvResultFile.hpp"
+
+#include <array>
+#include <vector>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*! \brief Class that reads results in CSV file format.
+         *
+         * The result file is memory-mapped by a \ref CsvResultFile. Per frame, the two rows bracketing the
+         * visualization time are tokenized and only the columns of the bound attributes are converted. During
+         * playback, the upper row of one frame is the lower row of one of the next frames, thus it is reused.
+         */
+        class VisualizerCSV : public VisualizerAbstract
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            VisualizerCSV() = delete;
+
+            /*! \brief Constructs a VisualizerCSV object from the given arguments.
+             *
+             * Essentially a CSV file and its path need to be specified.
+             *
+             * \param modelFile  Model file name without path.
+             * \param path       Path to the model file.
+             */
+            VisualizerCSV(const std::string& modelFile, const std::string& path);
+
+            virtual ~VisualizerCSV() = default;
+
+            VisualizerCSV(const VisualizerCSV& rhs) = delete;
+
+            VisualizerCSV& operator=(const VisualizerCSV& rhs) = delete;
+
+            /*-----------------------------------------
+             * INITIALIZATION METHODS
+             *---------------------------------------*/
+
+            void setSimulationSettings(const UserSimSettingsMAT& simSetCSV);
+
+         private:
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            CsvResultFile _csvFile;
+
+            /// Position in \a _columns of every variable of the shape table. Built in \ref bindVisAttributes.
+            std::vector<std::size_t> _slots;
+            /// The distinct columns referenced by \a _slots in ascending order.
+            std::vector<std::size_t> _columns;
+            /// Values of \a _columns in the lower and upper bracketing row.
+            std::array<std::vector<double>, 2> _rows;
+            /// The rows currently stored in \a _rows.
+            std::array<std::size_t, 2> _loadedRows;
+
+            /*-----------------------------------------
+             * PRIVATE METHODS
+             *---------------------------------------*/
+
+            void initData() override;
+
+            /*! \brief Initializes the visualization attributes in order to set the scene to the initial position. */
+            void initializeVisAttributes(const double time = -1.0) override;
+
+            /*! \brief Maps the CSV file and indexes its rows. */
+            void readCsv(const std::string& modelFile, const std::string& path);
+
+            /*! \brief Resolves the variables of the shape table to CSV columns.
+             *
+             * Variables that cannot be found in the result file are reported once, their attributes are made constant
+             * 0.0.
+             */
+            void bindVisAttributes();
+
+            /*! \brief Makes sure that the given row is stored in \a _rows[idx]. */
+            void loadRow(const std::size_t idx, const std::size_t row);
+
+            /*-----------------------------------------
+             * SIMULATION METHODS
+             *---------------------------------------*/
+
+            void simulate(Control::TimeManager& omvm) override
+            {
+            }
+
+            /*! \brief This method updates the visualization attributes after a time step has been performed.
+             *
+             * The method updates the actual data for the visualization bodies by using variables from the CSV file.
+             *
+             * \param time  The visualization time.
+             */
+            void updateVisAttributes(const double time) override;
+
+            /*! \brief For CSV file based visualization, nothing has to be done. Just get the visualizationAttributes. */
+            void updateScene(const double time) override;
+
+        };
+
+    }  // namespace Model
+}  // namespace OMVIS
+
+#endif /* INCLUDE_VISUALIZERCSV_HPP_ */
+/**
+ * \}
+ */
@@ -109,6 +109,11 @@ namespace OMVIS
 
             std::shared_ptr<InputData> _inputData;
 
+            /*! Value references of the variables of the shape table in the same order. */
+            std::vector<fmi1_value_reference_t> _valueRefs;
+            /*! Values of \a _valueRefs at the current frame. */
+            std::vector<fmi1_real_t> _fmuValues;
+
          public:
             /// \todo Remove, we do not need it because we have inputData.
             std::vector<Control::JoystickDevice*> _joysticks;
@@ -160,17 +165,13 @@ namespace OMVIS
              */
             void initializeVisAttributes(const double time = 0.0) override;
 
-            /*! \brief Helper function setVarReferencesInVisAttributes. */
-            fmi1_value_reference_t getVarReferencesForObjectAttribute(ShapeObjectAttribute* attr);
-
-            /*! \brief Sets the variable references in the visualization attributes.
+            /*! \brief Resolves the variables of the shape table to FMU value references.
+             *
+             * Variables that cannot be found in the FMU are reported once, their attributes are made constant 0.0.
              *
              * \remark The vis. attributes are encapsulated in the inherited member _baseData of class type VisualBase.
              */
             int setVarReferencesInVisAttributes();
-
-            /*! \brief Update the attributes of a shape. */
-            void updateObjectAttributeFMU(ShapeObjectAttribute* attr, fmi1_import_t* fmu);
         };
 
     }  // namespace Model
@@ -113,6 +113,8 @@ namespace OMVIS
 
             /*! Names of all output variables. */
             NetOff::VariableList _outputVars;
+            /*! Index in the real output values of every variable of the shape table. */
+            std::vector<std::size_t> _outputIndices;
 
             std::shared_ptr<InputData> _inputData;
 
@@ -189,11 +191,9 @@ namespace OMVIS
              */
             NetOff::VariableList getInputVariables();
 
+            /*! \brief Resolves the variables of the shape table to indices of the output variables. */
             int setVarReferencesInVisAttributes();
 
-            // Todo pass by const ref
-            fmi1_value_reference_t getVarReferencesForObjectAttribute(ShapeObjectAttribute* attr);
-
             /*-----------------------------------------
              * SIMULATION METHODS
              *---------------------------------------*/
@@ -28,7 +28,12 @@
 #define INCLUDE_VISUALIZERMAT_HPP_
 
 #include "Model/VisualizerAbstract.hpp"
-#include <read_matlab4.h>
+#include "Model/MatResultFile.hpp"
+#include "Model/BakedTransforms.hpp"
+#include "Model/MatPrefetcher.hpp"
+
+#include <memory>
+#include <vector>
 
 namespace OMVIS
 {
@@ -37,7 +42,13 @@ namespace OMVIS
 
         /*! \brief Class that reads results in MAT file format.
          *
+         * The result file is memory-mapped by a \ref MatResultFile. Its time cursor is moved once per frame,
+         * afterwards the dynamic attributes of the \ref ShapeTable are interpolated at the cursor in one batch.
          *
+         * If a baked transformation file (see \ref bake) for the result file exists, the precomputed frames are used
+         * instead. They are interpolated between the output times and no transformation is done at all. Otherwise, a
+         * \ref MatPrefetcher computes the upcoming frames in the current playback direction on a background thread.
+         * Only the first frame after a jump in time or a change of the speedup is computed on the GUI thread.
          */
         class VisualizerMAT : public VisualizerAbstract
         {
@@ -69,12 +80,29 @@ namespace OMVIS
 
             void setSimulationSettings(const UserSimSettingsMAT& simSetMAT);
 
+            /*! \brief Precomputes the final matrix, colour and size of every shape for every output time of the MAT
+             *         file and writes them to a baked transformation file next to it.
+             *
+             * The file is memory-mapped when the MAT file is opened the next time. Thus, scrubbing through long
+             * results does not need any interpolation or transformation anymore.
+             *
+             * \throws std::runtime_error if the MAT file cannot be read or the baked file cannot be written.
+             */
+            void bake();
+
          private:
             /*-----------------------------------------
              * MEMBERS
              *---------------------------------------*/
 
-            ModelicaMatReader _matReader;
+            MatResultFile _matFile;
+
+            /// The columns of the variables of the shape table in the same order. Built in \ref bindVisAttributes.
+            MatColumnBatch _batch;
+            /// Precomputed frames. Only open, if a baked transformation file for the MAT file exists.
+            BakedTransforms _baked;
+            /// Computes upcoming frames in the background. Declared after \a _matFile, since it reads from it.
+            std::unique_ptr<MatPrefetcher> _prefetcher;
 
             /*-----------------------------------------
              * PRIVATE METHODS
@@ -85,8 +113,23 @@ namespace OMVIS
             /*! \brief Initializes the visualization attributes in order to set the scene to the initial position. */
             void initializeVisAttributes(const double time = -1.0) override;
 
+            /*! \brief Opens the MAT file selectively.
+             *
+             * Only the variables referenced by non-constant attributes of the shapes are loaded. Thus, the shapes
+             * need to be initialized before.
+             */
             void readMat(const std::string& modelFile, const std::string& path);
 
+            /*! \brief Resolves the variables of the shape table to MAT file variables.
+             *
+             * Variables that cannot be found in the result file are reported once, their attributes are made constant
+             * 0.0.
+             */
+            void bindVisAttributes();
+
+            /*! \brief Interpolates the baked frames bracketing the given time into the shapes. */
+            void loadBakedFrame(const double time);
+
             /*-----------------------------------------
              * SIMULATION METHODS
              *---------------------------------------*/
@@ -106,20 +149,6 @@ namespace OMVIS
             /*! \brief For MAT file based visualization, nothing has to be done. Just get the visualizationAttributes. */
             void updateScene(const double time) override;
 
-            /*! \brief Update the attribute of the Object using a MAT result file. */
-            void updateObjectAttributeMAT(Model::ShapeObjectAttribute* attr, double time, ModelicaMatReader* reader);
-
-            /*! \brief Fetches the value of a variable at a certain time.
-             *
-             * \todo The method omc_matlab4_val which is called inside this method returns 0 on success. Thus, we
-             *       should test the return value.
-             *
-             * \param reader    The ModelicaMatReader object to use for reading the MAT file.
-             * \param varName   The name of the variable to fetch the value for.
-             * \param time      The time to get the value for.
-             * \return Value of the variable at the specified time.
-             */
-            double omcGetVarValue(ModelicaMatReader* reader, const char* varName, double time);
         };
 
     }  // namespace Model
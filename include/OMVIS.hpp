@@ -37,7 +37,7 @@
 #include "Model/SimSettingsFMU.hpp"
 #include "Model/VisualizerAbstract.hpp"
 #include "Model/InfoVisitor.hpp"
-#include "Model/UpdateVisitor.hpp"
+#include "Model/NodeUpdater.hpp"
 #include "Control/TimeManager.hpp"
 #include "Initialization/CommandLineArgs.hpp"
 #include "Initialization/Factory.hpp"
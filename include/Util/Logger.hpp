@@ -28,8 +28,13 @@
 #define INCLUDE_LOGGER_HPP_
 
 #ifdef USE_LOGGER
-#define LOGGER_WRITE(message,category,level) OMVIS::Util::Logger::write(message,category,level)
-#define LOGGER_WRITE_TUPLE(message,categoryLevel) OMVIS::Util::Logger::write(message,categoryLevel)
+// The message is only built, if it is written. Thus, filtered messages do not allocate.
+#define LOGGER_WRITE(message,category,level) \
+    do { if (OMVIS::Util::Logger::getInstance().isOutput(category,level)) \
+             OMVIS::Util::Logger::write(message,category,level); } while (0)
+#define LOGGER_WRITE_TUPLE(message,categoryLevel) \
+    do { if (OMVIS::Util::Logger::getInstance().isOutput(categoryLevel)) \
+             OMVIS::Util::Logger::write(message,categoryLevel); } while (0)
 #else
 #define LOGGER_WRITE(x,y,z)
 #define LOGGER_WRITE_TUPLE(x,y)
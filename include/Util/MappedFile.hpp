@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Util
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_MAPPEDFILE_HPP_
+#define INCLUDE_MAPPEDFILE_HPP_
+
+#include <cstddef>
+#include <string>
+
+namespace OMVIS
+{
+    namespace Util
+    {
+
+        /*! \brief Result of \ref MappedFile::open. */
+        enum MappedFileStatus
+        {
+            MF_OK = 0,
+            MF_CANNOT_OPEN = 1,
+            MF_EMPTY = 2,
+            MF_CANNOT_MAP = 3
+        };
+
+        /*! \brief A file that is mapped read-only into memory.
+         *
+         * The mapping is done by mmap on POSIX systems and by CreateFileMapping and MapViewOfFile on Windows. The
+         * access hints and \ref release are best effort, i.e., they are ignored if the system does not support them.
+         */
+        class MappedFile
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            MappedFile();
+
+            /*! \brief Unmaps the file. */
+            ~MappedFile();
+
+            MappedFile(const MappedFile& rhs) = delete;
+
+            MappedFile& operator=(const MappedFile& rhs) = delete;
+
+            /*-----------------------------------------
+             * INITIALIZATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Maps the whole file into memory. A mapped file is closed before.
+             *
+             * \param fileName  The file to map.
+             * \return MF_OK on success. Otherwise, the file is not mapped.
+             */
+            MappedFileStatus open(const std::string& fileName);
+
+            /*! \brief Unmaps the file. Does nothing, if no file is mapped. */
+            void close();
+
+            /*-----------------------------------------
+             * GETTERS and SETTERS
+             *---------------------------------------*/
+
+            bool isOpen() const
+            {
+                return nullptr != _data;
+            }
+
+            /*! \brief Returns the start address of the mapping or nullptr, if no file is mapped. */
+            const char* getData() const
+            {
+                return _data;
+            }
+
+            /*! \brief Returns the size of the mapping in bytes. */
+            std::size_t getSize() const
+            {
+                return _size;
+            }
+
+            /*! \brief Returns the number of ranges which have been released by \ref release since opening. */
+            std::size_t getNumReleases() const
+            {
+                return _numReleases;
+            }
+
+            /*-----------------------------------------
+             * SIMULATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Hints that the mapping is read from front to back. */
+            void adviseSequential();
+
+            /*! \brief Hints that the mapping is read at random positions. */
+            void adviseRandom();
+
+            /*! \brief Tells the system that the pages within [begin, end) are not needed anymore.
+             *
+             * Only whole pages are released. The range is read again from the file, if it is accessed later on.
+             */
+            void release(const char* begin, const char* end);
+
+         private:
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            //! Start address of the mapping.
+            const char* _data;
+            //! Size of the mapping in bytes.
+            std::size_t _size;
+            std::size_t _numReleases;
+#ifdef _WIN32
+            //! Handles of the file and of the file mapping object.
+            void* _fileHandle;
+            void* _mappingHandle;
+#endif
+        };
+
+    }  // namespace Util
+}  // namespace OMVIS
+
+#endif /* INCLUDE_MAPPEDFILE_HPP_ */
+/**
+ * \}
+ */
@@ -0,0 +1,262 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Util
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_STAGESTATISTICS_HPP_
+#define INCLUDE_STAGESTATISTICS_HPP_
+
+#include "Util/StageTimer.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace OMVIS
+{
+    namespace Util
+    {
+
+        /*! \brief Logarithmic histogram of stage durations.
+         *
+         * Every power of two between one microsecond and about one second is divided into \a subBuckets buckets.
+         * Thus, a percentile is accurate to about 9 percent, independent of the number of samples.
+         */
+        class StageHistogram
+        {
+         public:
+            /*! \brief Buckets per power of two. */
+            static constexpr std::size_t subBuckets = 8;
+            /*! \brief Powers of two above one microsecond. Longer samples are counted in the last bucket. */
+            static constexpr std::size_t octaves = 20;
+            static constexpr std::size_t numBuckets = subBuckets * octaves + 1;
+
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            StageHistogram();
+
+            ~StageHistogram() = default;
+
+            StageHistogram(const StageHistogram& rhs) = default;
+
+            StageHistogram& operator=(const StageHistogram& rhs) = default;
+
+            /*-----------------------------------------
+             * GETTERS and SETTERS
+             *---------------------------------------*/
+
+            /*! \brief Returns the number of samples. */
+            std::size_t getNumSamples() const;
+
+            /*! \brief Returns the duration in seconds below which the given fraction of the samples lies.
+             *
+             * \param fraction  The percentile as fraction, e.g., 0.99 for p99.
+             * \param other     Samples of another histogram, which are taken into account as well.
+             * \return The upper bound of the matching bucket or 0.0, if there are no samples.
+             */
+            double getPercentile(const double fraction, const StageHistogram& other) const;
+
+            /*-----------------------------------------
+             * SIMULATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Adds a sample of the given duration in seconds. */
+            void add(const double seconds);
+
+            /*! \brief Removes all samples. */
+            void clear();
+
+         private:
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            std::array<std::uint32_t, numBuckets> _counts;
+            std::size_t _numSamples;
+        };
+
+        /*! \brief Collects the durations of the \ref FrameStage "frame stages" from all threads.
+         *
+         * Every thread records into its own ring buffer. Recording is lock-free and does not allocate, i.e., it is
+         * cheap enough for the hot path. If a ring is full, because nobody collects, the sample is dropped.
+         *
+         * A single consumer, i.e., the statistics overlay, drains the rings by \ref collect into a histogram per
+         * stage. The percentiles are computed over a sliding window of the last one to two \a windowLength.
+         *
+         * A ring is released, when its thread exits, and reused by the next thread that records for the first time.
+         * Thus, the number of rings is bounded by the number of threads recording at the same time, even though
+         * every reload of a model starts new worker threads.
+         *
+         * \remark A thread should record into one statistics only, usually \ref getInstance. Every switch to other
+         *         statistics releases the ring of the thread and acquires another one.
+         */
+        class StageStatistics
+        {
+         public:
+            /*! \brief Samples per thread that can be buffered between two calls of \ref collect. */
+            static constexpr std::size_t ringSize = 1024;
+
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            /*! \brief Constructs statistics with the given length of a histogram window in seconds. */
+            explicit StageStatistics(const double windowLength = 2.0);
+
+            ~StageStatistics() = default;
+
+            StageStatistics(const StageStatistics& rhs) = delete;
+
+            StageStatistics& operator=(const StageStatistics& rhs) = delete;
+
+            /*! \brief Returns the statistics which are shared by the visualizers and the viewer. */
+            static StageStatistics& getInstance();
+
+            /*-----------------------------------------
+             * GETTERS and SETTERS
+             *---------------------------------------*/
+
+            /*! \brief Returns the duration of the given percentile of a stage in seconds.
+             *
+             * \param stage     The stage.
+             * \param fraction  The percentile as fraction, e.g., 0.5 for the median.
+             */
+            double getPercentile(const FrameStage stage, const double fraction) const;
+
+            /*! \brief Returns the number of samples of the given stage in the sliding window. */
+            std::size_t getNumSamples(const FrameStage stage) const;
+
+            /*! \brief Returns the number of samples which have been dropped because a ring was full. */
+            std::size_t getNumDropped() const;
+
+            /*! \brief Returns the number of ring buffers, i.e., the maximal number of threads which have recorded at
+             *         the same time.
+             */
+            std::size_t getNumRings() const;
+
+            /*-----------------------------------------
+             * SIMULATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Records a sample of the given stage on the calling thread. Lock-free. */
+            void record(const FrameStage stage, const double seconds);
+
+            /*! \brief Records every stage of a frame, which has been entered, i.e., which took any time. */
+            void record(const FrameTimes& times);
+
+            /*! \brief Moves the samples of all threads into the histograms. Must not be called concurrently. */
+            void collect();
+
+            /*! \brief Discards all samples, the buffered ones as well. Must not be called concurrently to
+             *         \ref collect.
+             */
+            void reset();
+
+         private:
+            /*! \brief A sample of a stage. */
+            struct Sample
+            {
+                float seconds;
+                std::uint32_t stage;
+            };
+
+            /*! \brief Single producer single consumer ring buffer of one thread. */
+            struct Ring
+            {
+                std::array<Sample, ringSize> samples;
+                //! Written by the producer only.
+                std::atomic<std::size_t> head{0};
+                //! Written by the consumer only.
+                std::atomic<std::size_t> tail{0};
+                //! Set while a thread records into the ring.
+                std::atomic<bool> inUse{false};
+            };
+
+            /*! \brief The ring a thread records into. The ring is released, when the thread exits.
+             *
+             * The lease shares the ownership of the ring, such that a thread can exit after the statistics have been
+             * destroyed.
+             */
+            struct RingLease
+            {
+                //! Id of the statistics the ring belongs to, 0 if there is no ring.
+                std::uint64_t owner = 0;
+                std::shared_ptr<Ring> ring;
+
+                ~RingLease()
+                {
+                    release();
+                }
+
+                void release()
+                {
+                    if (ring)
+                        ring->inUse.store(false, std::memory_order_release);
+                    ring.reset();
+                    owner = 0;
+                }
+            };
+
+            /*-----------------------------------------
+             * PRIVATE METHODS
+             *---------------------------------------*/
+
+            /*! \brief Returns the ring of the calling thread.
+             *
+             * The first call of a thread takes a released ring or creates a new one, if all rings are in use.
+             */
+            Ring& getLocalRing();
+
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            std::uint64_t _id;
+            //! Guards \a _rings and the assignment of the rings to the threads.
+            mutable std::mutex _ringsMutex;
+            std::vector<std::shared_ptr<Ring>> _rings;
+            std::atomic<std::size_t> _numDropped;
+
+            std::chrono::steady_clock::duration _windowLength;
+            std::chrono::steady_clock::time_point _windowStart;
+            //! Histograms of the current window.
+            std::array<StageHistogram, FS_NUM> _current;
+            //! Histograms of the previous window.
+            std::array<StageHistogram, FS_NUM> _previous;
+        };
+
+    }  // namespace Util
+}  // namespace OMVIS
+
+#endif /* INCLUDE_STAGESTATISTICS_HPP_ */
+/**
+ * \}
+ */
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Util
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_STAGETIMER_HPP_
+#define INCLUDE_STAGETIMER_HPP_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+namespace OMVIS
+{
+    namespace Util
+    {
+
+        /*! \brief The stages of a frame, i.e., of \ref Model::VisualizerAbstract::sceneUpdate and of rendering it.
+         *
+         * The input polling is part of the simulation steps, i.e., FS_INPUT is contained in FS_SIMULATE.
+         */
+        enum FrameStage : std::size_t
+        {
+            FS_INPUT = 0,      ///< Polling the joysticks for inputs.
+            FS_SIMULATE = 1,   ///< Stepping the FMU to the next visualization time.
+            FS_FETCH = 2,      ///< Fetching the attribute values from the result file or the FMU.
+            FS_TRANSFORM = 3,  ///< Computing the transformation matrices of the shapes.
+            FS_APPLY = 4,      ///< Passing the changed shapes to the scene graph.
+            FS_RENDER = 5,     ///< Culling and drawing the scene, i.e., a frame of the osg viewer.
+            FS_NUM = 6
+        };
+
+        /*! \brief Returns a short name of the given stage for reports. */
+        const char* getFrameStageName(const FrameStage stage);
+
+        /*! \brief Seconds spent in each \ref FrameStage. */
+        using FrameTimes = std::array<double, FS_NUM>;
+
+        /*! \brief Adds the time from its construction to its destruction to one stage of a \ref FrameTimes.
+         *
+         * The timer can be stopped early by \ref stop, e.g., if only the first part of a scope belongs to the stage.
+         */
+        class StageTimer
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            StageTimer(FrameTimes& times, const FrameStage stage)
+                    : _seconds(&times[stage]),
+                      _start(std::chrono::steady_clock::now())
+            {
+            }
+
+            ~StageTimer()
+            {
+                stop();
+            }
+
+            StageTimer(const StageTimer& rhs) = delete;
+
+            StageTimer& operator=(const StageTimer& rhs) = delete;
+
+            /*-----------------------------------------
+             * SIMULATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Adds the elapsed time to the stage. Further calls have no effect. */
+            void stop()
+            {
+                if (nullptr != _seconds)
+                {
+                    *_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+                    _seconds = nullptr;
+                }
+            }
+
+         private:
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            double* _seconds;
+            std::chrono::steady_clock::time_point _start;
+        };
+
+    }  // namespace Util
+}  // namespace OMVIS
+
+#endif /* INCLUDE_STAGETIMER_HPP_ */
+/**
+ * \}
+ */
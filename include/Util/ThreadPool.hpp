@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Util
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_THREADPOOL_HPP_
+#define INCLUDE_THREADPOOL_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OMVIS
+{
+    namespace Util
+    {
+
+        /*! \brief A fixed set of worker threads for data-parallel loops.
+         *
+         * \ref parallelFor splits an index range into chunks of \a grainSize indices. The workers and the calling
+         * thread take the next free chunk from a shared atomic counter until the range is exhausted. Thus, threads
+         * that finish early simply take more chunks.
+         *
+         * \remark \ref parallelFor must not be called concurrently or recursively.
+         */
+        class ThreadPool
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            /*! \brief Starts the worker threads.
+             *
+             * \param numWorkers    Number of worker threads in addition to the calling thread. By default, one less
+             *                      than the number of hardware threads.
+             */
+            explicit ThreadPool(const std::size_t numWorkers = defaultNumWorkers());
+
+            /*! \brief Stops and joins the worker threads. */
+            ~ThreadPool();
+
+            ThreadPool(const ThreadPool& rhs) = delete;
+
+            ThreadPool& operator=(const ThreadPool& rhs) = delete;
+
+            /*-----------------------------------------
+             * GETTERS and SETTERS
+             *---------------------------------------*/
+
+            /*! \brief Returns the number of threads that work on a loop, i.e., the workers and the calling thread. */
+            std::size_t getNumThreads() const;
+
+            /*! \brief Returns the number of hardware threads minus one for the calling thread. */
+            static std::size_t defaultNumWorkers();
+
+            /*-----------------------------------------
+             * SIMULATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Function processing the indices [begin, end) of a loop with the given context. */
+            using ChunkFunction = void (*)(const void* context, std::size_t begin, std::size_t end);
+
+            /*! \brief Calls func(begin, end) for all chunks of [0, size) and returns when all chunks are done.
+             *
+             * Ranges that fit into one chunk are processed by the calling thread only. The callable is passed by
+             * reference to the workers, thus the loop does not allocate, whatever the callable captures.
+             *
+             * \param size      Number of indices.
+             * \param grainSize Maximal number of indices per chunk.
+             * \param func      Callable processing the indices [begin, end).
+             * \throws The first exception thrown by func. The remaining chunks are skipped in that case.
+             */
+            template <typename Func>
+            void parallelFor(const std::size_t size, const std::size_t grainSize, const Func& func)
+            {
+                const ChunkFunction chunkFunction = [](const void* context, std::size_t begin, std::size_t end)
+                {
+                    (*static_cast<const Func*>(context))(begin, end);
+                };
+                parallelFor(size, grainSize, chunkFunction, &func);
+            }
+
+            /*! \brief Calls func(context, begin, end) for all chunks of [0, size). See the templated version. */
+            void parallelFor(const std::size_t size, const std::size_t grainSize, const ChunkFunction func,
+                             const void* context);
+
+         private:
+            /*-----------------------------------------
+             * PRIVATE METHODS
+             *---------------------------------------*/
+
+            /*! \brief The loop of a worker thread. */
+            void run();
+
+            /*! \brief Processes chunks of the current loop until none is left. */
+            void work();
+
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            std::vector<std::thread> _workers;
+
+            //! Protects the members of the current loop and the counters below.
+            std::mutex _mutex;
+            std::condition_variable _wakeUp;
+            std::condition_variable _done;
+
+            //! The current loop.
+            ChunkFunction _func;
+            const void* _context;
+            std::size_t _size;
+            std::size_t _grainSize;
+            //! First index of the next free chunk.
+            std::atomic<std::size_t> _next;
+            //! The first exception thrown by \a _func.
+            std::exception_ptr _error;
+
+            //! Number of loops started so far.
+            std::size_t _loop;
+            //! Number of workers that did not finish the current loop yet.
+            std::size_t _busy;
+            bool _stop;
+        };
+
+    }  // namespace Util
+}  // namespace OMVIS
+
+#endif /* INCLUDE_THREADPOOL_HPP_ */
+/**
+ * \}
+ */
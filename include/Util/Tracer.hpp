@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Util
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_TRACER_HPP_
+#define INCLUDE_TRACER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace OMVIS
+{
+    namespace Util
+    {
+
+        /*! \brief Writes timestamped events of a session to a file in the Chrome trace event format.
+         *
+         * The file can be opened in chrome://tracing or in the Perfetto UI. Every \ref TraceScope becomes a complete
+         * event, i.e., an event with begin and duration, on the track of the thread it has been recorded on.
+         *
+         * Recording only appends the event to a buffer, which is swapped by a writer thread every 100 ms. The
+         * buffers keep their capacity, thus, recording does not allocate once the buffers are large enough. If the
+         * tracer is not started, which is the default, a \ref TraceScope costs a single atomic load.
+         */
+        class Tracer
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            Tracer();
+
+            /*! \brief Stops the tracer, i.e., the remaining events are written. */
+            ~Tracer();
+
+            Tracer(const Tracer& rhs) = delete;
+
+            Tracer& operator=(const Tracer& rhs) = delete;
+
+            /*! \brief Returns the tracer of the session, which is started by the command line option --trace. */
+            static Tracer& getInstance();
+
+            /*-----------------------------------------
+             * INITIALIZATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Opens the trace file and starts recording. A running trace is stopped before.
+             *
+             * \param fileName  The trace file, e.g., trace.json.
+             * \throws std::runtime_error, if the file cannot be opened.
+             */
+            void start(const std::string& fileName);
+
+            /*! \brief Stops recording, writes the remaining events and closes the file. Does nothing, if the tracer
+             *         is not started.
+             */
+            void stop();
+
+            /*-----------------------------------------
+             * GETTERS and SETTERS
+             *---------------------------------------*/
+
+            /*! \brief Returns true, if the events are recorded. */
+            bool isEnabled() const
+            {
+                return _enabled.load(std::memory_order_acquire);
+            }
+
+            /*! \brief Returns the time since the start of the trace in nanoseconds. */
+            std::int64_t now() const
+            {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()
+                        - _origin).count();
+            }
+
+            /*-----------------------------------------
+             * SIMULATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Records a complete event of the calling thread.
+             *
+             * \param name      Name of the event. It is not copied, i.e., it has to be a string literal.
+             * \param category  Category of the event, e.g., "fmi". It is not copied either.
+             * \param begin     Begin of the event as returned by \ref now.
+             * \param end       End of the event as returned by \ref now.
+             */
+            void record(const char* name, const char* category, const std::int64_t begin, const std::int64_t end);
+
+         private:
+            /*! \brief A complete event. */
+            struct Event
+            {
+                const char* name;
+                const char* category;
+                std::uint32_t threadId;
+                std::int64_t begin;
+                std::int64_t duration;
+            };
+
+            /*-----------------------------------------
+             * PRIVATE METHODS
+             *---------------------------------------*/
+
+            /*! \brief The loop of the writer thread. */
+            void runWriter();
+
+            /*! \brief Appends the given events to the trace file. */
+            void writeEvents(const std::vector<Event>& events);
+
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            std::atomic<bool> _enabled;
+            std::chrono::steady_clock::time_point _origin;
+
+            //! Guards \a _pending and \a _stopping. Events are not accepted while stopping.
+            std::mutex _mutex;
+            std::condition_variable _condition;
+            //! Events recorded since the last swap.
+            std::vector<Event> _pending;
+            bool _stopping;
+
+            //! The members below are used by the writer thread only, while it is running.
+            std::thread _writer;
+            std::vector<Event> _writing;
+            std::ofstream _file;
+            bool _firstEvent;
+        };
+
+        /*! \brief Records the time from its construction to its destruction as event of the \ref Tracer.
+         *
+         * The scope is only measured, if the tracer has been started before its construction.
+         */
+        class TraceScope
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            /*! \brief Starts the event. The name and the category have to be string literals. */
+            TraceScope(const char* name, const char* category)
+                    : _name(name),
+                      _category(category),
+                      _begin(Tracer::getInstance().isEnabled() ? Tracer::getInstance().now() : -1)
+            {
+            }
+
+            ~TraceScope()
+            {
+                if (0 <= _begin)
+                    Tracer::getInstance().record(_name, _category, _begin, Tracer::getInstance().now());
+            }
+
+            TraceScope(const TraceScope& rhs) = delete;
+
+            TraceScope& operator=(const TraceScope& rhs) = delete;
+
+         private:
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            const char* _name;
+            const char* _category;
+            //! Begin in nanoseconds since the start of the trace or -1, if the tracer is not running.
+            std::int64_t _begin;
+        };
+
+    }  // namespace Util
+}  // namespace OMVIS
+
+#endif /* INCLUDE_TRACER_HPP_ */
+/**
+ * \}
+ */
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Util
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_TRANSFORMKERNEL_HPP_
+#define INCLUDE_TRANSFORMKERNEL_HPP_
+
+#include "Model/ShapeType.hpp"
+
+#include <cstddef>
+
+namespace OMVIS
+{
+    namespace Util
+    {
+
+        /*! \brief Coefficients describing how the transformation of a shape depends on its type.
+         *
+         * They replace the type distinction of \ref rotation by arithmetic. Each coefficient is either 0.0 or 1.0,
+         * except for the offset.
+         */
+        enum TransformCoefficient : std::size_t
+        {
+            TC_OFFSET = 0,  ///< Fraction of the length the shape is moved along lDir, i.e., 0.5 for centred shapes.
+            TC_ORIENT = 1,  ///< 1.0, if the orientation of lDir and wDir is applied on top of T.
+            TC_SPHERE = 2,  ///< 1.0, if lDir is mapped to the x axis instead of the z axis.
+            TC_ROTATE = 3,  ///< 1.0, if r_shape (plus offset) is rotated by T.
+            TC_ORIGIN = 4,  ///< 1.0, if r is added to the position.
+            TC_SCALE = 5,   ///< 1.0, if the shape is a unit primitive, which is scaled to its width, height and length.
+            TC_HEIGHT = 6,  ///< 1.0, if the local y axis is scaled by the height instead of the width, i.e., for boxes.
+            TC_NUM = 7
+        };
+
+        /*! \brief Returns the values of all \ref TransformCoefficient for the given shape type.
+         *
+         * \param type      The shape type.
+         * \param values    Output array with \a TC_NUM elements.
+         */
+        void getTransformCoefficients(const Model::ShapeType type, float* values);
+
+        /*! \brief The attributes of a batch of shapes as structure of arrays.
+         *
+         * Every pointer refers to an array with one value per shape.
+         */
+        struct TransformInputs
+        {
+            const float* r[3];
+            const float* rShape[3];
+            const float* T[9];
+            const float* lDir[3];
+            const float* wDir[3];
+            const float* length;
+            const float* width;
+            const float* height;
+            const float* coefficients[TC_NUM];
+        };
+
+        /*! \brief Computes the 4x4 transformation matrices of the shapes [begin, end).
+         *
+         * This is the batched version of \ref rotation followed by \ref assemblePokeMatrix. The direction fixes of
+         * \ref fixDirections, i.e., the fallbacks for a vanishing lDir and for wDir parallel to lDir, are done by
+         * selects instead of branches. If OMVIS is compiled with AVX2 support, eight shapes are processed at once.
+         *
+         * The matrices of unit primitives (\a TC_SCALE) additionally scale the local axes, i.e., the length, width
+         * and height of the shape are folded into its matrix.
+         *
+         * \param in        The attributes of the shapes.
+         * \param begin     First shape of the batch.
+         * \param end       One past the last shape of the batch.
+         * \param matrices  Row-major matrices as used by osg::Matrixd, i.e., 16 values per shape starting with shape 0.
+         */
+        void transformBatch(const TransformInputs& in, const std::size_t begin, const std::size_t end,
+                            double* matrices);
+
+    }  // namespace Util
+}  // namespace OMVIS
+
+#endif /* INCLUDE_TRANSFORMKERNEL_HPP_ */
+/**
+ * \}
+ */
@@ -213,6 +213,12 @@ namespace OMVIS
             return (mat != std::string::npos);
         }
 
+        inline bool isCSV(const std::string& fileIn)
+        {
+            std::size_t csv = fileIn.find(".csv");
+            return (csv != std::string::npos);
+        }
+
         /*! \brief Creates the name of the xml visual file from model name and path.
          *
          * \param modelFile   Name of the file containing the model, e.g., modelFoo.fmu
@@ -227,8 +233,8 @@ namespace OMVIS
             {
                 signsOff = 4;
             }
-            // modelFoo_res.mat --> -8 signs
-            else if (isMAT(modelFile))
+            // modelFoo_res.mat or modelFoo_res.csv --> -8 signs
+            else if (isMAT(modelFile) || isCSV(modelFile))
             {
                 signsOff = 8;
             }
@@ -237,13 +243,26 @@ namespace OMVIS
             {
                 // todo: Handle this case.
             }
-            // Cut off prefix [fmu|mat]
+            // Cut off prefix [fmu|mat|csv]
             std::string fileName = modelFile.substr(0, modelFile.length() - signsOff);
             // Construct XML file name
             std::string xmlFileName = path + fileName + "_visual.xml";
             return xmlFileName;
         }
 
+        /*! \brief Creates the name of the baked transformation file from the name and path of a MAT file.
+         *
+         * \param modelFile   Name of the result file, e.g., modelFoo_res.mat
+         * \param path        Path where the result file is stored, e.g., /home/usr/models/
+         * \return Baked transformation file name, e.g., /home/usr/models/modelFoo_res.bake
+         */
+        inline std::string getBakeFileName(const std::string& modelFile, const std::string& path)
+        {
+            // Cut off prefix mat
+            std::string fileName = isMAT(modelFile) ? modelFile.substr(0, modelFile.length() - 4) : modelFile;
+            return path + fileName + ".bake";
+        }
+
         /*! Checks if the visual XML file for the given model and path is present.
          *
          * \param modelFile   Name of the file containing the model, e.g., modelFoo.fmu
@@ -32,6 +32,7 @@
 
 #include "WrapperFMILib.hpp"
 #include "Model/ShapeObjectAttribute.hpp"
+#include "Model/ShapeObject.hpp"
 
 #include <rapidxml.hpp>
 
@@ -106,9 +107,6 @@ namespace OMVIS
         /*! \brief Update the attribute of the object using a MAT file result. */
         void updateObjectAttributeFMU(Model::ShapeObjectAttribute* attr, double time, fmi1_import_t* fmu);
 
-        /*! \brief Update the attribute of the object using remote FMU visualization. */
-        void updateObjectAttributeFMUClient(Model::ShapeObjectAttribute& attr, const NetOff::ValueContainer& _outputCont);
-
         /*! \brief Gets the value of the indicated node exp. */
         double getShapeAttrFMU(const char* attr, rapidxml::xml_node<>* node, double time, fmi1_import_t* fmu);
 
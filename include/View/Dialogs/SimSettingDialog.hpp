@@ -92,7 +92,7 @@ namespace OMVIS
          *
          * At the moment, the user can set the speed of the visualization by choosing a speed up value. The
          * visualization of the simulation result is slowed down if speed up < 1 and accelerated if the speed up > 1,
-         * respectively.
+         * respectively. A negative speed up plays the result backwards.
          */
         class SimSettingDialogMAT : public OkCancelHelpButtonBox
         {
@@ -32,6 +32,7 @@
 #include "Control/TimeManager.hpp"
 #include "Control/GUIController.hpp"
 #include "View/ViewSettings.hpp"
+#include "View/StatisticsOverlay.hpp"
 
 #include <QTimer>
 #include <QMainWindow>
@@ -317,6 +318,9 @@ namespace OMVIS
             /*! \brief The view which holds the osg scene. */
             osg::ref_ptr<osgViewer::View> _sceneView;
 
+            /*! \brief The head-up display of the stage statistics, which is toggled by the key 'p'. */
+            osg::ref_ptr<StatisticsOverlay> _statisticsOverlay;
+
             // --- Widgets---
             /// Widget which handles the OSG scene.
             QWidget* _osgViewerWidget;
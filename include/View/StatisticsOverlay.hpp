@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup View
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_STATISTICSOVERLAY_HPP_
+#define INCLUDE_STATISTICSOVERLAY_HPP_
+
+#include <osg/Camera>
+#include <osgText/Text>
+
+#include <chrono>
+
+namespace OMVIS
+{
+    namespace View
+    {
+
+        /*! \brief Head-up display of the percentiles of the \ref Util::FrameStage "frame stages".
+         *
+         * The overlay is a post render camera, which is added as slave to the view next to the one of
+         * osgViewer::StatsHandler. It shows the median and the 99th percentile of every stage, as collected by
+         * \ref Util::StageStatistics. The text is refreshed by the update traversal a few times per second.
+         *
+         * The overlay is hidden by a node mask of zero. It is toggled by the \ref Control::KeyboardEventHandler.
+         */
+        class StatisticsOverlay : public osg::Camera
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            /*! \brief Constructs the hidden overlay for the given graphics context. */
+            explicit StatisticsOverlay(osg::GraphicsContext* context);
+
+            StatisticsOverlay(const StatisticsOverlay& rhs) = delete;
+
+            StatisticsOverlay& operator=(const StatisticsOverlay& rhs) = delete;
+
+            /*-----------------------------------------
+             * SIMULATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Collects the recorded samples and shows their percentiles, if the last refresh is long enough
+             *         ago.
+             */
+            void refresh();
+
+         protected:
+            /// Referenced objects are destroyed by unref.
+            ~StatisticsOverlay() = default;
+
+         private:
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            //! The stage names, the medians and the 99th percentiles in columns.
+            osg::ref_ptr<osgText::Text> _names;
+            osg::ref_ptr<osgText::Text> _medians;
+            osg::ref_ptr<osgText::Text> _tails;
+            std::chrono::steady_clock::time_point _lastRefresh;
+        };
+
+    }  // namespace View
+}  // namespace OMVIS
+
+#endif /* INCLUDE_STATISTICSOVERLAY_HPP_ */
+/**
+ * \}
+ */
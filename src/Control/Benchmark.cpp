@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Control/Benchmark.hpp"
+#include "Util/Logger.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+namespace OMVIS
+{
+    namespace Control
+    {
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        Benchmark::Benchmark(std::shared_ptr<Model::VisualizerAbstract> visualizer)
+                : _visualizer(visualizer),
+                  _numFrames(0),
+                  _initTime(0.0),
+                  _playTime(0.0),
+                  _totalTimes(),
+                  _maxTimes()
+        {
+        }
+
+        /*-----------------------------------------
+         * SIMULATION METHODS
+         *---------------------------------------*/
+
+        void Benchmark::run()
+        {
+            using Clock = std::chrono::steady_clock;
+            _numFrames = 0;
+            _totalTimes.fill(0.0);
+            _maxTimes.fill(0.0);
+
+            const Clock::time_point initStart = Clock::now();
+            _visualizer->initialize();
+            _visualizer->initVisualization();
+            _initTime = std::chrono::duration<double>(Clock::now() - initStart).count();
+
+            LOGGER_WRITE("Benchmark " + _visualizer->getModelFile() + ".", Util::LC_CTR, Util::LL_INFO);
+            auto timeManager = _visualizer->getTimeManager();
+            _visualizer->startVisualization();
+
+            const Clock::time_point playStart = Clock::now();
+            while (!timeManager->isPaused())
+            {
+                _visualizer->sceneUpdate();
+                const Util::FrameTimes& frameTimes = _visualizer->getFrameTimes();
+                for (std::size_t stage = 0; stage < Util::FS_NUM; ++stage)
+                {
+                    _totalTimes[stage] += frameTimes[stage];
+                    _maxTimes[stage] = std::max(_maxTimes[stage], frameTimes[stage]);
+                }
+                ++_numFrames;
+            }
+            _playTime = std::chrono::duration<double>(Clock::now() - playStart).count();
+        }
+
+        /*-----------------------------------------
+         * GETTERS and SETTERS
+         *---------------------------------------*/
+
+        std::size_t Benchmark::getNumFrames() const
+        {
+            return _numFrames;
+        }
+
+        double Benchmark::getFramesPerSecond() const
+        {
+            return (0.0 < _playTime) ? _numFrames / _playTime : 0.0;
+        }
+
+        const Util::FrameTimes& Benchmark::getTotalTimes() const
+        {
+            return _totalTimes;
+        }
+
+        const Util::FrameTimes& Benchmark::getMaxTimes() const
+        {
+            return _maxTimes;
+        }
+
+        std::size_t Benchmark::getPeakRSS()
+        {
+#ifndef _WIN32
+            struct rusage usage;
+            if (0 != getrusage(RUSAGE_SELF, &usage))
+                return 0;
+#ifdef __APPLE__
+            // Bytes on macOS.
+            return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+            // Kilobytes on Linux.
+            return static_cast<std::size_t>(usage.ru_maxrss) * 1024u;
+#endif
+#else
+            return 0;
+#endif
+        }
+
+        /*-----------------------------------------
+         * PRINT METHODS
+         *---------------------------------------*/
+
+        void Benchmark::print(std::ostream& os) const
+        {
+            const auto& table = _visualizer->getBaseData()->_shapeTable;
+            const std::ios::fmtflags flags = os.flags();
+            os << std::fixed << std::setprecision(3);
+            os << "\nBenchmark of " << _visualizer->getModelFile() << "\n";
+            os << "  Shapes: " << table.getNumShapes() << " (" << table.getConstShapes().size() << " constant)\n";
+            os << "  Variables: " << table.getNumVariables() << "\n";
+            os << "  Frames: " << _numFrames << "\n";
+            os << "  Initialization: " << _initTime << " s\n";
+            os << "  Playback: " << _playTime << " s, " << getFramesPerSecond() << " frames/s\n";
+            os << "  " << std::left << std::setw(12) << "Stage" << std::right << std::setw(12) << "total [s]"
+               << std::setw(16) << "mean [ms]" << std::setw(16) << "max [ms]" << "\n";
+            for (std::size_t stage = 0; stage < Util::FS_NUM; ++stage)
+            {
+                // Nothing is rendered in the headless mode.
+                if (Util::FS_RENDER == stage)
+                    continue;
+                const double mean = (0 < _numFrames) ? _totalTimes[stage] / _numFrames : 0.0;
+                const char* name = Util::getFrameStageName(static_cast<Util::FrameStage>(stage));
+                os << "  " << std::left << std::setw(12) << name << std::right << std::setw(12) << _totalTimes[stage]
+                   << std::setw(16) << 1.e3 * mean << std::setw(16) << 1.e3 * _maxTimes[stage] << "\n";
+            }
+            os << "  Peak RSS: " << getPeakRSS() / (1024.0 * 1024.0) << " MiB" << std::endl;
+            os.flags(flags);
+        }
+
+    }  // namespace Control
+}  // namespace OMVIS
@@ -21,6 +21,7 @@
 #include "Control/TimeManager.hpp"
 #include "Model/VisualizerFMU.hpp"
 #include "Model/VisualizerMAT.hpp"
+#include "Model/VisualizerCSV.hpp"
 #include "Model/VisualizerFMUClient.hpp"
 #include "Initialization/Factory.hpp"
 #include "Util/Logger.hpp"
@@ -265,6 +266,11 @@ namespace OMVIS
             return visTypeIs(Model::VisType::MAT_REMOTE);
         }
 
+        bool GUIController::visTypeIsCSV() const
+        {
+            return visTypeIs(Model::VisType::CSV);
+        }
+
         std::string GUIController::getModelFile() const
         {
             return _modelVisualizer->getModelFile();
@@ -332,6 +338,10 @@ namespace OMVIS
                 std::dynamic_pointer_cast<Model::VisualizerMAT>(_modelVisualizer)->setSimulationSettings(simSetMAT);
                 //initVisualization();
             }
+            else if (visTypeIsCSV())
+            {
+                std::dynamic_pointer_cast<Model::VisualizerCSV>(_modelVisualizer)->setSimulationSettings(simSetMAT);
+            }
             else if (visTypeIsMATRemote())
             {
                 LOGGER_WRITE("Not yet implemented for MAT Remote visualization.", Util::LC_CTR, Util::LL_INFO);
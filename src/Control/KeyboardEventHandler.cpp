@@ -20,6 +20,7 @@
 #include "Control/KeyboardEventHandler.hpp"
 #include "Model/InputData.hpp"
 #include "Util/Logger.hpp"
+#include "Util/StageStatistics.hpp"
 
 #include <string>
 
@@ -32,9 +33,13 @@ namespace OMVIS
          * CONSTRUCTORS
          *---------------------------------------*/
 
-        KeyboardEventHandler::KeyboardEventHandler(std::shared_ptr<Model::InputData> inputs)
+        constexpr int KeyboardEventHandler::statisticsKey;
+
+        KeyboardEventHandler::KeyboardEventHandler(std::shared_ptr<Model::InputData> inputs,
+                                                   osg::ref_ptr<osg::Node> statisticsOverlay)
                 : GUIEventHandler(),
-                  _inputs(std::move(inputs))
+                  _inputs(std::move(inputs)),
+                  _statisticsOverlay(std::move(statisticsOverlay))
         {
         }
 
@@ -44,13 +49,32 @@ namespace OMVIS
 
         bool KeyboardEventHandler::handle(const osgGA::GUIEventAdapter& ea, osgGA::GUIActionAdapter& /*aa*/)
         {
-            switch (ea.getEventType())
+            // The statistics key is reserved. Neither the model inputs nor other handlers get its events.
+            const osgGA::GUIEventAdapter::EventType eventType = ea.getEventType();
+            if (statisticsKey == ea.getKey()
+                    && (osgGA::GUIEventAdapter::KEYDOWN == eventType || osgGA::GUIEventAdapter::KEYUP == eventType))
+            {
+                if (osgGA::GUIEventAdapter::KEYDOWN == eventType && nullptr != _statisticsOverlay)
+                {
+                    // Show only the samples recorded from now on.
+                    const bool show = (0 == _statisticsOverlay->getNodeMask());
+                    if (show)
+                        Util::StageStatistics::getInstance().reset();
+                    _statisticsOverlay->setNodeMask(show ? 0xffffffff : 0);
+                }
+                return true;
+            }
+
+            switch (eventType)
             {
                 case (osgGA::GUIEventAdapter::KEYDOWN):
                 {
                     LOGGER_WRITE("KEYDOWN", Util::LC_CTR, Util::LL_DEBUG);
                     unsigned int keyboardValue = ea.getKey();  // the ascii value corresponding to the pressed key
 
+                    if (nullptr == _inputs)
+                        break;
+
                     auto keyboardmapValue = _inputs->getKeyboardMap()->find(keyboardValue);
 
                     if (keyboardmapValue != _inputs->getKeyboardMap()->end())
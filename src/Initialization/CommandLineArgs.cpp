@@ -39,6 +39,9 @@ namespace OMVIS
                   modelFile(),
                   modelPath(),
                   wDir(),
+                  bake(false),
+                  benchmark(false),
+                  trace(),
                   logSet()
         {
         }
@@ -97,6 +100,9 @@ namespace OMVIS
                 cout << "  Model File: " << modelFile << endl;
                 cout << "  Model Path: " << modelPath << endl;
                 cout << "  Working Directory: " << wDir << endl;
+                cout << "  Bake: " << Util::boolToString(bake) << endl;
+                cout << "  Benchmark: " << Util::boolToString(benchmark) << endl;
+                cout << "  Trace: " << trace << endl;
                 logSet.print();
             }
         }
@@ -142,6 +148,16 @@ namespace OMVIS
                         "port", boost::program_options::value<int>(), "Port to use for remote visualization.")(
                         "wdir", boost::program_options::value<std::string>(),
                         "Local working directory for remote visualization.")(
+                        "bake", "Precomputes the transformations of all shapes for every output time of a MAT result "
+                        "file, stores them next to the result file and exits. The next visualization of the result "
+                        "file uses them for instant scrubbing.")(
+                        "benchmark", "Replays the whole time line of the model as fast as possible without opening a "
+                        "window. Prints the time of each stage of a frame, the frames per second and the peak "
+                        "memory usage and exits.")(
+                        "trace", po::value<std::string>(),
+                        "Writes timestamped events of every scene update, simulation step, FMI call, network transfer "
+                        "and rendered frame to the given file in the Chrome trace format. The file can be opened in "
+                        "chrome://tracing or in the Perfetto UI.")(
                         "loggerSettings,l", po::value<std::vector<std::string> >(),
                         "Specification of the logging information.\n"
                         "Available categories: loader, controller, viewer, solver, other.\n"
@@ -237,6 +253,21 @@ namespace OMVIS
                         result.wDir = vm["wdir"].as<std::string>();
                     }
 
+                    if (0u != vm.count("bake"))
+                    {
+                        result.bake = true;
+                    }
+
+                    if (0u != vm.count("benchmark"))
+                    {
+                        result.benchmark = true;
+                    }
+
+                    if (0u != vm.count("trace"))
+                    {
+                        result.trace = vm["trace"].as<std::string>();
+                    }
+
                 }
                 catch (po::error& e)
                 {
@@ -298,6 +329,11 @@ namespace OMVIS
                             "No (local) working directory for remote visualization given. Use --wdir=/PATH/TO/WORKDING/DIR/.");
                 }
             }
+
+            if (clArgs.bake && (remoteVis || !Util::isMAT(clArgs.modelFile)))
+            {
+                throw std::runtime_error("Baking is only supported for local visualization of MAT result files.");
+            }
         }
 
     }  // namespace Initialization
@@ -20,6 +20,7 @@
 #include "Model/VisualizerFMU.hpp"
 #include "Model/VisualizerFMUClient.hpp"
 #include "Model/VisualizerMAT.hpp"
+#include "Model/VisualizerCSV.hpp"
 #include "Initialization/Factory.hpp"
 #include "Util/Logger.hpp"
 
@@ -69,6 +70,12 @@ namespace OMVIS
                 result = std::shared_ptr<Model::VisualizerAbstract>(new Model::VisualizerMAT(cP->modelFile, cP->path));
                 LOGGER_WRITE("Initialize VisualizerMAT.", Util::LC_LOADER, Util::LL_DEBUG);
             }
+            // CSV file based visualization
+            else if (cP->visType == Model::VisType::CSV)
+            {
+                result = std::shared_ptr<Model::VisualizerAbstract>(new Model::VisualizerCSV(cP->modelFile, cP->path));
+                LOGGER_WRITE("Initialize VisualizerCSV.", Util::LC_LOADER, Util::LL_DEBUG);
+            }
             // FMU based remote visualization
             else if (cP->visType == Model::VisType::FMU_REMOTE)
             {
@@ -55,6 +55,10 @@ namespace OMVIS
             {
                 visType = Model::VisType::MAT;
             }
+            else if (Util::isCSV(modelFile))
+            {
+                visType = Model::VisType::CSV;
+            }
             else
             {
                 throw std::invalid_argument("VisualizationType is NONE.");
@@ -18,6 +18,9 @@
  */
 
 #include "OMVIS.hpp"
+#include "Model/VisualizerMAT.hpp"
+#include "Control/Benchmark.hpp"
+#include "Util/Tracer.hpp"
 
 #include <stdexcept>
 #include <iostream>
@@ -40,6 +43,44 @@ int main(int argc, char* argv[])
         Util::Logger::initialize(clArgs.logSet);
         Util::Logger logger = Util::Logger::getInstance();
 
+        // The trace is written until the tracer is destroyed at exit.
+        if (!clArgs.trace.empty())
+        {
+            Util::Tracer::getInstance().start(clArgs.trace);
+        }
+
+        // Bake the transformations of a MAT file without opening a window.
+        if (clArgs.bake)
+        {
+            Initialization::Factory factory;
+            Initialization::VisualizationConstructionPlan cP = clArgs.getVisualizationConstructionPlan();
+            auto visualizer = std::dynamic_pointer_cast<Model::VisualizerMAT>(factory.createVisualizerObject(&cP));
+            visualizer->bake();
+            return 0;
+        }
+
+        // Replay the model without opening a window and print the timings.
+        if (clArgs.benchmark)
+        {
+            Initialization::Factory factory;
+            std::shared_ptr<Model::VisualizerAbstract> visualizer;
+            if (clArgs.remoteVisualization())
+            {
+                Initialization::RemoteVisualizationConstructionPlan cP =
+                        clArgs.getRemoteVisualizationConstructionPlan();
+                visualizer = factory.createVisualizerObject(&cP);
+            }
+            else
+            {
+                Initialization::VisualizationConstructionPlan cP = clArgs.getVisualizationConstructionPlan();
+                visualizer = factory.createVisualizerObject(&cP);
+            }
+            Control::Benchmark benchmark(visualizer);
+            benchmark.run();
+            benchmark.print(std::cout);
+            return 0;
+        }
+
         LOGGER_WRITE("Okay, let's create the main widget...", Util::LC_OTHER, Util::LL_INFO);
         QApplication app(argc, argv);
 
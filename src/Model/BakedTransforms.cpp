@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/BakedTransforms.hpp"
+#include "Model/ShapeObject.hpp"
+#include "Util/Logger.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        namespace
+        {
+            const char bakedMagic[8] = { 'O', 'M', 'V', 'I', 'S', 'B', 'K', '\0' };
+            // Version 2: The matrices include the scale of the unit primitives.
+            const std::uint32_t bakedVersion = 2;
+        }
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        BakedTransforms::BakedTransforms()
+                : _file(),
+                  _data(nullptr),
+                  _size(0),
+                  _numShapes(0),
+                  _numRows(0),
+                  _times(nullptr),
+                  _frames(nullptr)
+        {
+        }
+
+        BakedTransforms::~BakedTransforms()
+        {
+            close();
+        }
+
+        /*-----------------------------------------
+         * INITIALIZATION METHODS
+         *---------------------------------------*/
+
+        BakedHeader BakedTransforms::makeHeader(const std::string& matFileName, const std::string& xmlFileName,
+                                                const std::size_t numShapes, const std::size_t numRows)
+        {
+            BakedHeader header;
+            std::memcpy(header.magic, bakedMagic, sizeof(bakedMagic));
+            header.version = bakedVersion;
+            header.numShapes = static_cast<std::uint32_t>(numShapes);
+            header.numRows = numRows;
+            header.matFileSize = 0;
+            header.matFileTime = 0;
+            header.xmlFileTime = 0;
+
+            boost::system::error_code error;
+            const boost::uintmax_t matFileSize = boost::filesystem::file_size(matFileName, error);
+            if (!error)
+            {
+                header.matFileSize = static_cast<std::uint64_t>(matFileSize);
+                header.matFileTime = static_cast<std::int64_t>(boost::filesystem::last_write_time(matFileName, error));
+            }
+            const std::time_t xmlFileTime = boost::filesystem::last_write_time(xmlFileName, error);
+            if (!error)
+                header.xmlFileTime = static_cast<std::int64_t>(xmlFileTime);
+            return header;
+        }
+
+        bool BakedTransforms::open(const std::string& fileName, const std::string& matFileName,
+                                   const std::string& xmlFileName, const std::size_t numShapes)
+        {
+            close();
+
+            const Util::MappedFileStatus status = _file.open(fileName);
+            if (Util::MF_CANNOT_OPEN == status || Util::MF_CANNOT_MAP == status)
+                return false;
+
+            if (Util::MF_EMPTY == status || sizeof(BakedHeader) > _file.getSize())
+            {
+                _file.close();
+                LOGGER_WRITE("Ignoring baked transformation file " + fileName + ". The file is truncated.",
+                             Util::LC_LOADER, Util::LL_WARNING);
+                return false;
+            }
+
+            _data = _file.getData();
+            _size = _file.getSize();
+
+            BakedHeader header;
+            std::memcpy(&header, _data, sizeof(BakedHeader));
+            const BakedHeader expected = makeHeader(matFileName, xmlFileName, numShapes, header.numRows);
+            const std::size_t expectedSize = sizeof(BakedHeader) + header.numRows * sizeof(double)
+                    + header.numRows * numShapes * sizeof(BakedShape);
+
+            if (0 != std::memcmp(header.magic, bakedMagic, sizeof(bakedMagic)) || bakedVersion != header.version
+                    || expected.numShapes != header.numShapes || expected.matFileSize != header.matFileSize
+                    || expected.matFileTime != header.matFileTime || expected.xmlFileTime != header.xmlFileTime
+                    || 0 == header.numRows || expectedSize != _size)
+            {
+                LOGGER_WRITE("Ignoring baked transformation file " + fileName + ". It does not belong to " + matFileName
+                             + " or the current visual XML file. Run OMVIS --bake again.",
+                             Util::LC_LOADER, Util::LL_WARNING);
+                close();
+                return false;
+            }
+
+            _numShapes = numShapes;
+            _numRows = header.numRows;
+            _times = reinterpret_cast<const double*>(_data + sizeof(BakedHeader));
+            _frames = reinterpret_cast<const BakedShape*>(_data + sizeof(BakedHeader) + _numRows * sizeof(double));
+
+            LOGGER_WRITE("Using baked transformations from " + fileName + ".", Util::LC_LOADER, Util::LL_INFO);
+            return true;
+        }
+
+        void BakedTransforms::close()
+        {
+            _file.close();
+            _data = nullptr;
+            _size = 0;
+            _numShapes = 0;
+            _numRows = 0;
+            _times = nullptr;
+            _frames = nullptr;
+        }
+
+        /*-----------------------------------------
+         * GETTERS and SETTERS
+         *---------------------------------------*/
+
+        bool BakedTransforms::isOpen() const
+        {
+            return nullptr != _data;
+        }
+
+        std::size_t BakedTransforms::findRow(const double time, float& weight) const
+        {
+            weight = 0.0f;
+            // The first row with t(row) > time. Rows with the same time, as they occur at events, are skipped.
+            const double* upper = std::upper_bound(_times, _times + _numRows, time);
+            if (_times == upper)
+                return 0;
+            if (_times + _numRows == upper)
+                return _numRows - 1;
+
+            const std::size_t row = static_cast<std::size_t>(upper - _times) - 1;
+            weight = static_cast<float>((time - _times[row]) / (_times[row + 1] - _times[row]));
+            return row;
+        }
+
+        const BakedShape* BakedTransforms::getFrame(const std::size_t row) const
+        {
+            return _frames + row * _numShapes;
+        }
+
+        void BakedTransforms::record(const ShapeObject& shape, BakedShape& rec)
+        {
+            const double* mat = shape._mat.ptr();
+            for (int k = 0; k < 16; ++k)
+                rec.mat[k] = static_cast<float>(mat[k]);
+            for (int k = 0; k < 3; ++k)
+                rec.color[k] = shape._color[k].exp;
+            rec.length = shape._length.exp;
+            rec.width = shape._width.exp;
+            rec.height = shape._height.exp;
+            rec.extra = shape._extra.exp;
+        }
+
+        void BakedTransforms::interpolate(const BakedShape& lo, const BakedShape& hi, const float weight,
+                                          BakedShape& rec)
+        {
+            for (int k = 0; k < 16; ++k)
+                rec.mat[k] = lo.mat[k] + weight * (hi.mat[k] - lo.mat[k]);
+            for (int k = 0; k < 3; ++k)
+                rec.color[k] = lo.color[k] + weight * (hi.color[k] - lo.color[k]);
+            rec.length = lo.length + weight * (hi.length - lo.length);
+            rec.width = lo.width + weight * (hi.width - lo.width);
+            rec.height = lo.height + weight * (hi.height - lo.height);
+            rec.extra = lo.extra + weight * (hi.extra - lo.extra);
+        }
+
+        bool BakedTransforms::restore(const BakedShape& rec, ShapeObject& shape)
+        {
+            BakedShape current;
+            record(shape, current);
+            if (0 == std::memcmp(&current, &rec, sizeof(BakedShape)))
+                return false;
+
+            shape._mat.set(rec.mat);
+            for (int k = 0; k < 3; ++k)
+                shape._color[k].exp = rec.color[k];
+            shape._length.exp = rec.length;
+            shape._width.exp = rec.width;
+            shape._height.exp = rec.height;
+            shape._extra.exp = rec.extra;
+            return true;
+        }
+
+    }  // namespace Model
+}  // namespace OMVIS
@@ -0,0 +1,407 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/CsvResultFile.hpp"
+#include "Util/Logger.hpp"
+
+#include <algorithm>
+#include <clocale>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef __APPLE__
+#include <xlocale.h>
+#endif
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        namespace
+        {
+            //! Number of rows the cursor is moved forward before falling back to the sparse row index.
+            const std::size_t maxCursorSteps = 16;
+
+            void throwCsvError(const std::string& fileName, const std::string& reason)
+            {
+                auto msg = "Could not read CSV file " + fileName + ". " + reason;
+                LOGGER_WRITE(msg, Util::LC_LOADER, Util::LL_ERROR);
+                throw std::runtime_error(msg);
+            }
+
+            /*! \brief Returns the position of the first separator, line break or the end, whatever comes first. */
+            const char* fieldEnd(const char* pos, const char* end)
+            {
+                while (pos != end && ',' != *pos && '\n' != *pos && '\r' != *pos)
+                    ++pos;
+                return pos;
+            }
+
+            /*! \brief Converts the null-terminated string to a double in the C locale, i.e., independent of the
+             *         decimal separator of the user's locale.
+             */
+            double strtodC(const char* str, char** strEnd)
+            {
+#ifndef _WIN32
+                static const locale_t cLocale = newlocale(LC_ALL_MASK, "C", nullptr);
+                return strtod_l(str, strEnd, cLocale);
+#else
+                static const _locale_t cLocale = _create_locale(LC_ALL, "C");
+                return _strtod_l(str, strEnd, cLocale);
+#endif
+            }
+        }
+
+        constexpr std::size_t CsvResultFile::indexStride;
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        CsvResultFile::CsvResultFile()
+                : _fileName(""),
+                  _file(),
+                  _data(nullptr),
+                  _size(0),
+                  _varIndices(),
+                  _rowOffsets(),
+                  _rowTimes(),
+                  _numRows(0),
+                  _stopTime(0.0),
+                  _cursorRow(0),
+                  _cursorWeight(0.0),
+                  _cursorPos { nullptr, nullptr },
+                  _cursorTime { 0.0, 0.0 }
+        {
+        }
+
+        CsvResultFile::~CsvResultFile()
+        {
+            close();
+        }
+
+        /*-----------------------------------------
+         * INITIALIZATION METHODS
+         *---------------------------------------*/
+
+        void CsvResultFile::open(const std::string& fileName)
+        {
+            mapFile(fileName);
+            try
+            {
+                parseHeader();
+                buildIndex();
+                setCursor(0, _data + _rowOffsets[0]);
+            }
+            catch (...)
+            {
+                close();
+                throw;
+            }
+            LOGGER_WRITE("Indexed " + std::to_string(_numRows) + " rows of " + std::to_string(_varIndices.size())
+                         + " variables in CSV file " + fileName + ".", Util::LC_LOADER, Util::LL_DEBUG);
+        }
+
+        void CsvResultFile::mapFile(const std::string& fileName)
+        {
+            close();
+            _fileName = fileName;
+
+            switch (_file.open(fileName))
+            {
+                case Util::MF_CANNOT_OPEN:
+                    throwCsvError(fileName, "The file cannot be opened.");
+                    break;
+                case Util::MF_EMPTY:
+                    throwCsvError(fileName, "The file is empty.");
+                    break;
+                case Util::MF_CANNOT_MAP:
+                    throwCsvError(fileName, "The file cannot be mapped into memory.");
+                    break;
+                default:
+                    break;
+            }
+
+            _data = _file.getData();
+            _size = _file.getSize();
+            // The file is read front to back while indexing.
+            _file.adviseSequential();
+        }
+
+        void CsvResultFile::parseHeader()
+        {
+            const char* end = _data + _size;
+            const char* lineEnd = nextRow(_data);
+            const char* pos = _data;
+            std::size_t column = 0;
+            while (pos < lineEnd)
+            {
+                while (pos != lineEnd && ' ' == *pos)
+                    ++pos;
+
+                // Names like "a.T[1,1]" contain separators, so quotes have to be respected.
+                const char* nameBegin = pos;
+                const char* nameEnd;
+                if (pos != lineEnd && '"' == *pos)
+                {
+                    nameBegin = ++pos;
+                    nameEnd = static_cast<const char*>(std::memchr(pos, '"', lineEnd - pos));
+                    if (nullptr == nameEnd)
+                        throwCsvError(_fileName, "Unterminated variable name in header.");
+                    pos = fieldEnd(nameEnd + 1, end);
+                }
+                else
+                {
+                    pos = fieldEnd(pos, end);
+                    nameEnd = pos;
+                    while (nameEnd != nameBegin && ' ' == *(nameEnd - 1))
+                        --nameEnd;
+                }
+
+                if (nameBegin != nameEnd)
+                    _varIndices.emplace(std::string(nameBegin, nameEnd), column);
+                ++column;
+
+                if (pos == end || ',' != *pos)
+                    break;
+                ++pos;
+            }
+
+            if (_varIndices.empty())
+                throwCsvError(_fileName, "The header does not contain any variable.");
+        }
+
+        void CsvResultFile::buildIndex()
+        {
+            const char* end = _data + _size;
+            const char* pos = nextRow(_data);
+            const char* last = nullptr;
+            std::size_t row = 0;
+            while (pos != end && '\n' != *pos && '\r' != *pos)
+            {
+                if (0 == row % indexStride)
+                {
+                    _rowOffsets.push_back(static_cast<std::size_t>(pos - _data));
+                    _rowTimes.push_back(parseValue(pos, fieldEnd(pos, end)));
+                }
+                last = pos;
+                ++row;
+                pos = nextRow(pos);
+            }
+
+            if (0 == row)
+                throwCsvError(_fileName, "The file does not contain any data row.");
+
+            _numRows = row;
+            _stopTime = parseValue(last, fieldEnd(last, end));
+            _file.adviseRandom();
+        }
+
+        void CsvResultFile::close()
+        {
+            _file.close();
+            _data = nullptr;
+            _size = 0;
+            _varIndices.clear();
+            _rowOffsets.clear();
+            _rowTimes.clear();
+            _numRows = 0;
+            _stopTime = 0.0;
+            _cursorRow = 0;
+            _cursorWeight = 0.0;
+            _cursorPos[0] = _cursorPos[1] = nullptr;
+            _cursorTime[0] = _cursorTime[1] = 0.0;
+        }
+
+        /*-----------------------------------------
+         * GETTERS and SETTERS
+         *---------------------------------------*/
+
+        bool CsvResultFile::isOpen() const
+        {
+            return nullptr != _data;
+        }
+
+        bool CsvResultFile::findVariable(const std::string& varName, std::size_t& column) const
+        {
+            auto it = _varIndices.find(varName);
+            if (_varIndices.end() == it)
+                return false;
+
+            column = it->second;
+            return true;
+        }
+
+        std::size_t CsvResultFile::getNumRows() const
+        {
+            return _numRows;
+        }
+
+        double CsvResultFile::getStartTime() const
+        {
+            return _rowTimes.front();
+        }
+
+        double CsvResultFile::getStopTime() const
+        {
+            return _stopTime;
+        }
+
+        double CsvResultFile::getTime(const std::size_t row) const
+        {
+            const char* pos = rowBegin(row);
+            return parseValue(pos, fieldEnd(pos, _data + _size));
+        }
+
+        /*-----------------------------------------
+         * SIMULATION METHODS
+         *---------------------------------------*/
+
+        void CsvResultFile::seek(const double time)
+        {
+            if (time <= getStartTime())
+            {
+                setCursor(0, _data + _rowOffsets[0]);
+                _cursorWeight = 0.0;
+                return;
+            }
+            if (time >= _stopTime)
+            {
+                setCursor(_numRows - 1, rowBegin(_numRows - 1));
+                _cursorWeight = 0.0;
+                return;
+            }
+
+            // Now we know that t(0) < time < t(last), thus the loops below stop before the last row.
+            std::size_t steps = 0;
+            while (steps < maxCursorSteps && _cursorRow + 1 < _numRows && _cursorTime[1] <= time)
+            {
+                setCursor(_cursorRow + 1, _cursorPos[1]);
+                ++steps;
+            }
+
+            if (!(_cursorTime[0] <= time && time < _cursorTime[1]))
+            {
+                const std::size_t block = std::upper_bound(_rowTimes.begin(), _rowTimes.end(), time)
+                        - _rowTimes.begin() - 1;
+                setCursor(block * indexStride, _data + _rowOffsets[block]);
+                while (_cursorTime[1] <= time)
+                    setCursor(_cursorRow + 1, _cursorPos[1]);
+            }
+
+            _cursorWeight = (time - _cursorTime[0]) / (_cursorTime[1] - _cursorTime[0]);
+        }
+
+        std::size_t CsvResultFile::getCursorRow() const
+        {
+            return _cursorRow;
+        }
+
+        double CsvResultFile::getCursorWeight() const
+        {
+            return _cursorWeight;
+        }
+
+        void CsvResultFile::readRow(const std::size_t row, const std::vector<std::size_t>& columns,
+                                    double* values) const
+        {
+            const char* end = _data + _size;
+            const char* pos = rowBegin(row);
+            std::size_t field = 0;
+            bool lineEnd = false;
+            for (std::size_t i = 0; i < columns.size(); ++i)
+            {
+                while (!lineEnd && field < columns[i])
+                {
+                    pos = fieldEnd(pos, end);
+                    if (pos != end && ',' == *pos)
+                    {
+                        ++pos;
+                        ++field;
+                    }
+                    else
+                    {
+                        lineEnd = true;
+                    }
+                }
+                values[i] = lineEnd ? 0.0 : parseValue(pos, fieldEnd(pos, end));
+            }
+        }
+
+        /*-----------------------------------------
+         * PRIVATE METHODS
+         *---------------------------------------*/
+
+        const char* CsvResultFile::rowBegin(const std::size_t row) const
+        {
+            const char* pos = _data + _rowOffsets[row / indexStride];
+            for (std::size_t i = 0; i < row % indexStride; ++i)
+                pos = nextRow(pos);
+            return pos;
+        }
+
+        const char* CsvResultFile::nextRow(const char* pos) const
+        {
+            const char* end = _data + _size;
+            const char* lineBreak = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+            return (nullptr == lineBreak) ? end : lineBreak + 1;
+        }
+
+        double CsvResultFile::parseValue(const char* begin, const char* end) const
+        {
+            // Trailing spaces belong to the separator, leading ones are skipped by strtod.
+            while (end != begin && ' ' == *(end - 1))
+                --end;
+
+            char buffer[64];
+            const std::size_t length = static_cast<std::size_t>(end - begin);
+            if (0 == length || sizeof(buffer) <= length)
+                throwCsvError(_fileName, "Invalid value \"" + std::string(begin, end) + "\".");
+
+            std::memcpy(buffer, begin, length);
+            buffer[length] = '\0';
+            char* parseEnd = nullptr;
+            const double value = strtodC(buffer, &parseEnd);
+            if (buffer + length != parseEnd)
+                throwCsvError(_fileName, "Invalid value \"" + std::string(begin, end) + "\".");
+            return value;
+        }
+
+        void CsvResultFile::setCursor(const std::size_t row, const char* pos)
+        {
+            const char* end = _data + _size;
+            _cursorRow = row;
+            _cursorPos[0] = pos;
+            _cursorTime[0] = parseValue(pos, fieldEnd(pos, end));
+            if (row + 1 < _numRows)
+            {
+                _cursorPos[1] = nextRow(pos);
+                _cursorTime[1] = parseValue(_cursorPos[1], fieldEnd(_cursorPos[1], end));
+            }
+            else
+            {
+                _cursorPos[1] = pos;
+                _cursorTime[1] = _cursorTime[0];
+            }
+        }
+
+    }  // namespace Model
+}  // namespace OMVIS
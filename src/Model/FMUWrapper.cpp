@@ -18,6 +18,7 @@
  */
 
 #include "Util/Logger.hpp"
+#include "Util/Tracer.hpp"
 #include "Util/Util.hpp"
 #include <FMI/fmi_import_util.h>
 #include <Model/FMUWrapper.hpp>
@@ -136,6 +137,7 @@ namespace OMVIS
 
         void FMUWrapper::initialize(const std::shared_ptr<SimSettingsFMU> simSettings)
         {
+            Util::TraceScope trace("FMUWrapper::initialize", "fmi");
             // Initialize data
             _fmuData._hcur = simSettings->getHdef();
             _fmuData._tcur = simSettings->getTstart();
@@ -202,6 +204,7 @@ namespace OMVIS
 
         void FMUWrapper::setContinuousStates()
         {
+            Util::TraceScope trace("fmi1_import_set_continuous_states", "fmi");
             _fmuData._fmiStatus = fmi1_import_set_continuous_states(_fmu.get(), _fmuData._states, _fmuData._nStates);
         }
 
@@ -251,11 +254,13 @@ namespace OMVIS
 
         void FMUWrapper::fmi1ImportGetDerivatives()
         {
+            Util::TraceScope trace("fmi1_import_get_derivatives", "fmi");
             _fmuData._fmiStatus = fmi1_import_get_derivatives(_fmu.get(), _fmuData._statesDer, _fmuData._nStates);
         }
 
         void FMUWrapper::handleEvents(const fmi1_boolean_t intermediateResults)
         {
+            Util::TraceScope trace("FMUWrapper::handleEvents", "fmi");
             // LOGGER_WRITE("Handle event at " + std::to_string(_fmuData._tcur), Util::LC_CTR, Util::LL_DEBUG);
             _fmuData._fmiStatus = fmi1_import_eventUpdate(_fmu.get(), intermediateResults, &_fmuData._eventInfo);
             _fmuData._fmiStatus = fmi1_import_get_continuous_states(_fmu.get(), _fmuData._states, _fmuData._nStates);
@@ -267,6 +272,7 @@ namespace OMVIS
 
         void FMUWrapper::prepareSimulationStep(const double time)
         {
+            Util::TraceScope trace("FMUWrapper::prepareSimulationStep", "fmi");
             _fmuData._fmiStatus = fmi1_import_set_time(_fmu.get(), time);
             _fmuData._fmiStatus = fmi1_import_get_event_indicators(_fmu.get(), _fmuData._eventIndicators,
                                                                    _fmuData._nEventIndicators);
@@ -284,19 +290,18 @@ namespace OMVIS
 
         void FMUWrapper::solveSystem()
         {
+            Util::TraceScope trace("fmi1_import_get_derivatives", "fmi");
             _fmuData._fmiStatus = fmi1_import_get_derivatives(_fmu.get(), _fmuData._statesDer, _fmuData._nStates);
         }
 
         void FMUWrapper::doEulerStep()
         {
-            for (size_t k = 0; k < _fmuData._nStates; ++k)
-            {
-                _fmuData._states[k] = _fmuData._states[k] + _fmuData._hcur * _fmuData._statesDer[k];
-            }
+            eulerStep(_fmuData._states, _fmuData._statesDer, _fmuData._hcur, _fmuData._nStates);
         }
 
         void FMUWrapper::completedIntegratorStep(fmi1_boolean_t* callEventUpdate)
         {
+            Util::TraceScope trace("fmi1_import_completed_integrator_step", "fmi");
             _fmuData._fmiStatus = fmi1_import_completed_integrator_step(_fmu.get(), callEventUpdate);
         }
 
@@ -304,6 +309,14 @@ namespace OMVIS
          * FREE METHODS
          *---------------------------------------*/
 
+        void eulerStep(fmi1_real_t* states, const fmi1_real_t* statesDer, const fmi1_real_t h, const size_t nStates)
+        {
+            for (size_t k = 0; k < nStates; ++k)
+            {
+                states[k] = states[k] + h * statesDer[k];
+            }
+        }
+
         /// \todo Return statement is missing.
         fmi1_base_type_enu_t getFMI1baseTypeFor4CharString(const std::string& typeString)
         {
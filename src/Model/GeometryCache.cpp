@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/GeometryCache.hpp"
+#include "Model/Shapes/Pipecylinder.hpp"
+#include "Model/Shapes/Spring.hpp"
+
+#include <cmath>
+#include <functional>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        constexpr float GeometryCache::quantum;
+        constexpr std::size_t GeometryCache::maxSize;
+
+        GeometryCache::GeometryCache()
+                : _geometries()
+        {
+        }
+
+        /*-----------------------------------------
+         * GETTERS and SETTERS
+         *---------------------------------------*/
+
+        osg::Geometry* GeometryCache::getPipecylinder(const float rI, const float rO, const float l)
+        {
+            const Key key = makeKey(ShapeType::PIPECYLINDER, rI, rO, 0.0f, l);
+            auto it = _geometries.find(key);
+            if (_geometries.end() != it)
+                return it->second.get();
+
+            return insert(key, new Pipecylinder(rI, rO, l));
+        }
+
+        osg::Geometry* GeometryCache::getSpring(const float r, const float rCoil, const float nWindings, const float l)
+        {
+            const Key key = makeKey(ShapeType::SPRING, r, rCoil, nWindings, l);
+            auto it = _geometries.find(key);
+            if (_geometries.end() != it)
+                return it->second.get();
+
+            return insert(key, new Spring(r, rCoil, nWindings, l));
+        }
+
+        std::size_t GeometryCache::getSize() const
+        {
+            return _geometries.size();
+        }
+
+        void GeometryCache::clear()
+        {
+            _geometries.clear();
+        }
+
+        bool GeometryCache::equal(const float a, const float b)
+        {
+            return std::lround(a / quantum) == std::lround(b / quantum);
+        }
+
+        /*-----------------------------------------
+         * PRIVATE METHODS
+         *---------------------------------------*/
+
+        std::size_t GeometryCache::KeyHash::operator()(const Key& key) const
+        {
+            std::size_t hash = std::hash<int>()(static_cast<int>(key.type));
+            for (const long param : key.params)
+                hash = hash * 31 + std::hash<long>()(param);
+            return hash;
+        }
+
+        GeometryCache::Key GeometryCache::makeKey(const ShapeType type, const float p0, const float p1, const float p2,
+                                                  const float p3)
+        {
+            return Key { type, {{ std::lround(p0 / quantum), std::lround(p1 / quantum), std::lround(p2 / quantum),
+                                  std::lround(p3 / quantum) }} };
+        }
+
+        osg::Geometry* GeometryCache::insert(const Key& key, osg::Geometry* geometry)
+        {
+            geometry->setDataVariance(osg::Object::STATIC);
+            if (maxSize > _geometries.size())
+                _geometries.emplace(key, geometry);
+            return geometry;
+        }
+
+    }  // namespace Model
+}  // namespace OMVIS
@@ -19,6 +19,7 @@
 
 #include "Model/InputData.hpp"
 #include "Util/Logger.hpp"
+#include "Util/Tracer.hpp"
 #include "Util/Util.hpp"
 
 #include <iostream>
@@ -240,6 +241,7 @@ namespace OMVIS
         /// \todo: What do we do with the variable status?
         void InputData::setInputsInFMU(fmi1_import_t* fmu)
         {
+            Util::TraceScope trace("InputData::setInputsInFMU", "fmi");
             fmi1_status_t status = fmi1_import_set_real(fmu, _inputVals._vrReal, _inputVals.getNumReal(),
                                                         _inputVals._valuesReal);
             status = fmi1_import_set_integer(fmu, _inputVals._vrInteger, _inputVals.getNumInteger(),
@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/MatPrefetcher.hpp"
+
+#include <cmath>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        namespace
+        {
+            //! Two visualization times closer than this are considered equal.
+            const double timeTolerance = 1.e-10;
+        }
+
+        constexpr std::size_t MatPrefetcher::ringSize;
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        MatPrefetcher::MatPrefetcher(const MatResultFile& matFile, const std::vector<ShapeObject>& shapes)
+                : _matFile(matFile),
+                  _shapes(shapes),
+                  _table(),
+                  _batch(),
+                  _cursor { 0, 0.0 },
+                  _ring(),
+                  _head(0),
+                  _tail(0),
+                  _generation(0),
+                  _mutex(),
+                  _wakeUp(),
+                  _nextTime(0.0),
+                  _step(0.0),
+                  _stop(false),
+                  _thread()
+        {
+            // Unresolved variables have already been made constant by the visualizer, thus all variables are found.
+            _table.build(_shapes);
+            for (std::size_t i = 0; i < _table.getNumVariables(); ++i)
+            {
+                MatColumn column;
+                _matFile.findVariable(_table.getVariable(i), column);
+                _matFile.addToBatch(column, _batch);
+            }
+            for (auto& frame : _ring)
+                frame.shapes.resize(_shapes.size());
+
+            _thread = std::thread(&MatPrefetcher::run, this);
+        }
+
+        MatPrefetcher::~MatPrefetcher()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop = true;
+            }
+            _wakeUp.notify_one();
+            _thread.join();
+        }
+
+        /*-----------------------------------------
+         * GETTERS and SETTERS
+         *---------------------------------------*/
+
+        std::size_t MatPrefetcher::getNumFrames() const
+        {
+            return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_relaxed);
+        }
+
+        /*-----------------------------------------
+         * SIMULATION METHODS
+         *---------------------------------------*/
+
+        void MatPrefetcher::restart(const double time, const double step)
+        {
+            // Drop all frames. A frame the producer is working on right now is dropped by the next pop.
+            _head.store(_tail.load(std::memory_order_acquire), std::memory_order_release);
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _nextTime = time;
+                _step = step;
+                ++_generation;
+            }
+            _wakeUp.notify_one();
+        }
+
+        bool MatPrefetcher::pop(const double time, std::vector<ShapeObject>& shapes, ShapeTable& table)
+        {
+            const unsigned int generation = _generation.load();
+            const std::size_t tail = _tail.load(std::memory_order_acquire);
+            std::size_t head = _head.load(std::memory_order_relaxed);
+            const bool wasFull = (tail - head >= ringSize);
+
+            // The step is only written by restart, i.e., by the consumer itself.
+            const bool reverse = (0.0 > _step);
+            bool found = false;
+            while (!found && head != tail)
+            {
+                const PrefetchedFrame& frame = _ring[head % ringSize];
+                if (frame.generation == generation)
+                {
+                    // Frames after the requested time in playback direction are kept for the following calls.
+                    const double ahead = reverse ? time - frame.time : frame.time - time;
+                    if (ahead > timeTolerance)
+                        break;
+                    if (ahead >= -timeTolerance)
+                    {
+                        for (std::size_t i = 0; i < shapes.size(); ++i)
+                        {
+                            if (BakedTransforms::restore(frame.shapes[i], shapes[i]))
+                                table.setDirty(i);
+                        }
+                        found = true;
+                    }
+                }
+                ++head;
+            }
+            _head.store(head, std::memory_order_release);
+
+            // The producer might sleep because the ring was full.
+            if (wasFull)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                }
+                _wakeUp.notify_one();
+            }
+            return found;
+        }
+
+        /*-----------------------------------------
+         * PRIVATE METHODS
+         *---------------------------------------*/
+
+        void MatPrefetcher::run()
+        {
+            const double startTime = _matFile.getStartTime();
+            const double stopTime = _matFile.getStopTime();
+
+            unsigned int generation = _generation.load();
+            double time = 0.0;
+            double step = 0.0;
+            bool active = false;
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (true)
+            {
+                _wakeUp.wait(lock, [&]
+                {
+                    return _stop || (!isFull() && (active || generation != _generation.load()));
+                });
+                if (_stop)
+                    return;
+
+                if (generation != _generation.load())
+                {
+                    generation = _generation.load();
+                    time = _nextTime;
+                    step = _step;
+                    active = true;
+                }
+                lock.unlock();
+
+                const std::size_t tail = _tail.load(std::memory_order_relaxed);
+                PrefetchedFrame& frame = _ring[tail % ringSize];
+                computeFrame(time, frame);
+                frame.generation = generation;
+                _tail.store(tail + 1, std::memory_order_release);
+
+                // Same accumulation as the visualization time in VisualizerAbstract::sceneUpdate.
+                time += step;
+                active = (0.0 != step && time >= startTime && time <= stopTime);
+                lock.lock();
+            }
+        }
+
+        void MatPrefetcher::computeFrame(const double time, PrefetchedFrame& frame)
+        {
+            _matFile.seek(time, _cursor);
+            _matFile.interpolate(_batch, _cursor, _table.getVariableValues());
+            _table.scatter();
+
+            frame.time = time;
+            double* matrices = _table.getMatrices();
+            Util::transformBatch(_table.getTransformInputs(), 0, _shapes.size(), matrices);
+            for (std::size_t i = 0; i < _shapes.size(); ++i)
+            {
+                _shapes[i]._mat.set(matrices + 16 * i);
+                BakedTransforms::record(_shapes[i], frame.shapes[i]);
+            }
+        }
+
+        bool MatPrefetcher::isFull() const
+        {
+            return _tail.load(std::memory_order_relaxed) - _head.load(std::memory_order_acquire) >= ringSize;
+        }
+
+    }  // namespace Model
+}  // namespace OMVIS
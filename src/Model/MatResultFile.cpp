@@ -0,0 +1,645 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/MatResultFile.hpp"
+#include "Util/Logger.hpp"
+#include "Util/MappedFile.hpp"
+
+#include <stdexcept>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        namespace
+        {
+            //! Number of rows the cursor is moved linearly before falling back to a binary search.
+            const std::size_t maxCursorSteps = 16;
+
+            //! Number of rows after which the decoded part of data_2 is released while loading selectively.
+            const std::size_t releaseRows = 4096;
+
+            /*! \brief Returns the size in bytes of a MAT v4 element of the given precision digit. */
+            std::size_t matValueSize(const int precision)
+            {
+                switch (precision)
+                {
+                    case 0:
+                        return 8;  // double
+                    case 1:
+                        return 4;  // float
+                    case 2:
+                        return 4;  // int32
+                    case 3:
+                        return 2;  // int16
+                    case 4:
+                        return 2;  // uint16
+                    case 5:
+                        return 1;  // uint8
+                    default:
+                        return 0;
+                }
+            }
+
+            std::int32_t readInt32(const char* ptr)
+            {
+                std::int32_t val;
+                std::memcpy(&val, ptr, sizeof(std::int32_t));
+                return val;
+            }
+
+            void throwMatError(const std::string& fileName, const std::string& reason)
+            {
+                auto msg = "Could not read MAT file " + fileName + ": " + reason;
+                LOGGER_WRITE(msg, Util::LC_LOADER, Util::LL_ERROR);
+                throw std::runtime_error(msg);
+            }
+        }
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        MatColumnBatch::MatColumnBatch()
+                : _addresses(),
+                  _rowMasks(),
+                  _signs(),
+                  _isDouble(),
+                  _allDouble(true)
+        {
+        }
+
+        void MatColumnBatch::clear()
+        {
+            _addresses.clear();
+            _rowMasks.clear();
+            _signs.clear();
+            _isDouble.clear();
+            _allDouble = true;
+        }
+
+        std::size_t MatColumnBatch::size() const
+        {
+            return _addresses.size();
+        }
+
+        MatResultFile::MatResultFile()
+                : _fileName(),
+                  _file(),
+                  _data(nullptr),
+                  _size(0),
+                  _varIndices(),
+                  _dataInfo(nullptr),
+                  _infoVarStride(0),
+                  _infoFieldStride(0),
+                  _data1(nullptr),
+                  _data2(nullptr),
+                  _data1ValueSize(0),
+                  _data2ValueSize(0),
+                  _data1VarStride(0),
+                  _data2VarStride(0),
+                  _data2RowStride(0),
+                  _rowBytes(0),
+                  _selectedRows(),
+                  _selectedColumns(),
+                  _numParams(0),
+                  _numVars(0),
+                  _numRows(0),
+                  _time(),
+                  _cursor { 0, 0.0 }
+        {
+        }
+
+        MatResultFile::~MatResultFile()
+        {
+            close();
+        }
+
+        /*-----------------------------------------
+         * INITIALIZATION METHODS
+         *---------------------------------------*/
+
+        void MatResultFile::open(const std::string& fileName)
+        {
+            mapFile(fileName);
+            try
+            {
+                parseMatrices(nullptr);
+            }
+            catch (...)
+            {
+                close();
+                throw;
+            }
+
+            LOGGER_WRITE("Mapped MAT file " + fileName + " with " + std::to_string(_varIndices.size()) + " variables and "
+                         + std::to_string(_numRows) + " time points.", Util::LC_LOADER, Util::LL_DEBUG);
+        }
+
+        void MatResultFile::open(const std::string& fileName, const std::vector<std::string>& varNames)
+        {
+            const std::unordered_set<std::string> names(varNames.begin(), varNames.end());
+            mapFile(fileName);
+            try
+            {
+                parseMatrices(&names);
+                loadSelectedColumns();
+            }
+            catch (...)
+            {
+                close();
+                throw;
+            }
+
+            LOGGER_WRITE("Loaded " + std::to_string(_selectedColumns.size()) + " columns for " + std::to_string(names.size())
+                         + " variables of MAT file " + fileName + " with " + std::to_string(_numVars) + " columns and "
+                         + std::to_string(_numRows) + " time points.", Util::LC_LOADER, Util::LL_DEBUG);
+        }
+
+        void MatResultFile::mapFile(const std::string& fileName)
+        {
+            close();
+            _fileName = fileName;
+
+            switch (_file.open(fileName))
+            {
+                case Util::MF_CANNOT_OPEN:
+                    throwMatError(fileName, "The file cannot be opened.");
+                    break;
+                case Util::MF_EMPTY:
+                    throwMatError(fileName, "The file is empty.");
+                    break;
+                case Util::MF_CANNOT_MAP:
+                    throwMatError(fileName, "The file cannot be mapped into memory.");
+                    break;
+                default:
+                    break;
+            }
+
+            _data = _file.getData();
+            _size = _file.getSize();
+        }
+
+        void MatResultFile::close()
+        {
+            _file.close();
+            _data = nullptr;
+            _size = 0;
+            _varIndices.clear();
+            _dataInfo = nullptr;
+            _data1 = nullptr;
+            _data2 = nullptr;
+            _numParams = 0;
+            _numVars = 0;
+            _numRows = 0;
+            _rowBytes = 0;
+            _selectedRows.clear();
+            _selectedRows.shrink_to_fit();
+            _selectedColumns.clear();
+            _cursor.row = 0;
+            _cursor.weight = 0.0;
+        }
+
+        /*-----------------------------------------
+         * GETTERS and SETTERS
+         *---------------------------------------*/
+
+        bool MatResultFile::isOpen() const
+        {
+            return nullptr != _data;
+        }
+
+        bool MatResultFile::findVariable(const std::string& varName, MatColumn& column) const
+        {
+            auto it = _varIndices.find(varName);
+            if (_varIndices.end() == it)
+                return false;
+
+            const std::size_t varIdx = it->second;
+            const std::int32_t dataSet = readInt32(_dataInfo + 4 * varIdx * _infoVarStride);
+            const std::int32_t colIdx = readInt32(_dataInfo + 4 * (varIdx * _infoVarStride + _infoFieldStride));
+            if (0 == colIdx)
+                return false;
+
+            const std::size_t col = static_cast<std::size_t>(0 > colIdx ? -colIdx : colIdx) - 1;
+            column.sign = (0 > colIdx) ? -1.0 : 1.0;
+
+            // Parameters are stored in data_1. Their value is taken from the first row and does not change in time.
+            if (1 == dataSet)
+            {
+                if (col >= _numParams)
+                    return false;
+                column.base = _data1 + col * _data1VarStride * _data1ValueSize;
+                column.rowStride = 0;
+                column.isDouble = (8 == _data1ValueSize);
+            }
+            else
+            {
+                if (col >= _numVars)
+                    return false;
+
+                if (_selectedRows.empty())
+                {
+                    column.base = _data2 + col * _data2VarStride * _data2ValueSize;
+                    column.isDouble = (8 == _data2ValueSize);
+                }
+                else
+                {
+                    auto selIt = _selectedColumns.find(col);
+                    if (_selectedColumns.end() == selIt)
+                        return false;
+                    column.base = reinterpret_cast<const char*>(_selectedRows.data() + selIt->second);
+                    column.isDouble = true;
+                }
+                column.rowStride = _rowBytes;
+            }
+            return true;
+        }
+
+        std::size_t MatResultFile::getNumRows() const
+        {
+            return _numRows;
+        }
+
+        std::size_t MatResultFile::getNumReleasedRanges() const
+        {
+            return _file.getNumReleases();
+        }
+
+        double MatResultFile::getStartTime() const
+        {
+            return _time.at(0);
+        }
+
+        double MatResultFile::getStopTime() const
+        {
+            return _time.at(_numRows - 1);
+        }
+
+        double MatResultFile::getTime(const std::size_t row) const
+        {
+            return _time.at(row);
+        }
+
+        /*-----------------------------------------
+         * SIMULATION METHODS
+         *---------------------------------------*/
+
+        void MatResultFile::seek(const double time)
+        {
+            seek(time, _cursor);
+        }
+
+        void MatResultFile::seek(const double time, MatCursor& cursor) const
+        {
+            const std::size_t lastRow = _numRows - 1;
+            if (time <= _time.at(0))
+            {
+                cursor.row = 0;
+                cursor.weight = 0.0;
+                return;
+            }
+            if (time >= _time.at(lastRow))
+            {
+                cursor.row = lastRow;
+                cursor.weight = 0.0;
+                return;
+            }
+
+            // Now we know that t(0) < time < t(last). Walk the cursor until t(row) <= time < t(row + 1).
+            std::size_t row = (cursor.row < lastRow) ? cursor.row : lastRow;
+            std::size_t steps = 0;
+            while (steps < maxCursorSteps && _time.at(row) > time)
+            {
+                --row;
+                ++steps;
+            }
+            while (steps < maxCursorSteps && _time.at(row + 1) <= time)
+            {
+                ++row;
+                ++steps;
+            }
+
+            cursor.row = (maxCursorSteps == steps) ? searchRow(time) : row;
+
+            const double tLo = _time.at(cursor.row);
+            const double tHi = _time.at(cursor.row + 1);
+            cursor.weight = (time - tLo) / (tHi - tLo);
+        }
+
+        void MatResultFile::seekRow(const std::size_t row)
+        {
+            _cursor.row = (row < _numRows) ? row : _numRows - 1;
+            _cursor.weight = 0.0;
+        }
+
+        void MatResultFile::addToBatch(const MatColumn& column, MatColumnBatch& batch) const
+        {
+            batch._addresses.push_back(static_cast<std::int64_t>(reinterpret_cast<std::intptr_t>(column.base)));
+            batch._rowMasks.push_back((0 == column.rowStride) ? 0 : ~static_cast<std::int64_t>(0));
+            batch._signs.push_back(column.sign);
+            batch._isDouble.push_back(column.isDouble ? 1 : 0);
+            batch._allDouble = batch._allDouble && column.isDouble;
+        }
+
+        void MatResultFile::interpolate(const MatColumnBatch& batch, float* values) const
+        {
+            interpolate(batch, _cursor, values);
+        }
+
+        void MatResultFile::interpolate(const MatColumnBatch& batch, const MatCursor& cursor, float* values) const
+        {
+            // Byte offsets of the bracketing rows. Parameters mask them out. If the cursor sits on a row, the upper
+            // row is not read at all, since it might be behind the last row.
+            const std::int64_t rowStride = static_cast<std::int64_t>(_rowBytes);
+            const std::int64_t rowLo = static_cast<std::int64_t>(cursor.row) * rowStride;
+            const std::int64_t rowHi = (0.0 == cursor.weight) ? rowLo : rowLo + rowStride;
+            const double weight = cursor.weight;
+
+            const std::size_t n = batch.size();
+            const std::int64_t* addresses = batch._addresses.data();
+            const std::int64_t* masks = batch._rowMasks.data();
+            const double* signs = batch._signs.data();
+            std::size_t i = 0;
+
+#ifdef __AVX2__
+            if (batch._allDouble)
+            {
+                const __m256i rowLoV = _mm256_set1_epi64x(rowLo);
+                const __m256i rowHiV = _mm256_set1_epi64x(rowHi);
+                const __m256d weightV = _mm256_set1_pd(weight);
+                for (; i + 4 <= n; i += 4)
+                {
+                    const __m256i addr = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(addresses + i));
+                    const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(masks + i));
+                    const __m256i addrLo = _mm256_add_epi64(addr, _mm256_and_si256(rowLoV, mask));
+                    const __m256i addrHi = _mm256_add_epi64(addr, _mm256_and_si256(rowHiV, mask));
+                    const __m256d lo = _mm256_i64gather_pd(nullptr, addrLo, 1);
+                    const __m256d hi = _mm256_i64gather_pd(nullptr, addrHi, 1);
+                    __m256d val = _mm256_add_pd(lo, _mm256_mul_pd(weightV, _mm256_sub_pd(hi, lo)));
+                    val = _mm256_mul_pd(val, _mm256_loadu_pd(signs + i));
+                    _mm_storeu_ps(values + i, _mm256_cvtpd_ps(val));
+                }
+            }
+#endif
+
+            for (; i < n; ++i)
+            {
+                const char* col = reinterpret_cast<const char*>(static_cast<std::intptr_t>(addresses[i]));
+                double lo, hi;
+                if (batch._isDouble[i])
+                {
+                    std::memcpy(&lo, col + (rowLo & masks[i]), sizeof(double));
+                    std::memcpy(&hi, col + (rowHi & masks[i]), sizeof(double));
+                }
+                else
+                {
+                    float loF, hiF;
+                    std::memcpy(&loF, col + (rowLo & masks[i]), sizeof(float));
+                    std::memcpy(&hiF, col + (rowHi & masks[i]), sizeof(float));
+                    lo = loF;
+                    hi = hiF;
+                }
+                values[i] = static_cast<float>(signs[i] * (lo + weight * (hi - lo)));
+            }
+        }
+
+        std::size_t MatResultFile::getCursorRow() const
+        {
+            return _cursor.row;
+        }
+
+        double MatResultFile::getCursorWeight() const
+        {
+            return _cursor.weight;
+        }
+
+        /*-----------------------------------------
+         * PRIVATE METHODS
+         *---------------------------------------*/
+
+        std::size_t MatResultFile::searchRow(const double time) const
+        {
+            // Find the first row with t(row) > time. The caller guarantees t(0) < time < t(last).
+            std::size_t lo = 0;
+            std::size_t hi = _numRows - 1;
+            while (hi - lo > 1)
+            {
+                const std::size_t mid = lo + (hi - lo) / 2;
+                if (_time.at(mid) <= time)
+                    lo = mid;
+                else
+                    hi = mid;
+            }
+            return lo;
+        }
+
+        void MatResultFile::parseMatrices(const std::unordered_set<std::string>* varNames)
+        {
+            bool transposed = false;
+            const char* names = nullptr;
+            std::size_t nameRows = 0, nameCols = 0;
+            std::size_t numInfoVars = 0;
+
+            std::size_t offset = 0;
+            while (offset + 20 <= _size)
+            {
+                const std::int32_t type = readInt32(_data + offset);
+                const std::int32_t rows = readInt32(_data + offset + 4);
+                const std::int32_t cols = readInt32(_data + offset + 8);
+                const std::int32_t imagf = readInt32(_data + offset + 12);
+                const std::int32_t nameLength = readInt32(_data + offset + 16);
+
+                // The MAT v4 type is encoded as MOPT. We only support little endian IEEE (M=0), the reserved O=0 and
+                // full matrices (T=0) or text matrices (T=1).
+                if (0 > type || 0 != type / 1000 || 0 != (type / 100) % 10 || 0 != imagf || 1 < type % 10)
+                    throwMatError(_fileName, "Unsupported matrix type " + std::to_string(type) + ".");
+                if (0 > rows || 0 > cols || 0 >= nameLength)
+                    throwMatError(_fileName, "The file is truncated or corrupt.");
+
+                // Check the size of the matrix without overflowing, since the dimensions are up to 2^31 each.
+                const std::size_t mrows = static_cast<std::size_t>(rows);
+                const std::size_t ncols = static_cast<std::size_t>(cols);
+                const std::size_t nameLen = static_cast<std::size_t>(nameLength);
+                const std::size_t valueSize = matValueSize((type / 10) % 10);
+                std::size_t remaining = _size - offset - 20;
+                if (0 == valueSize || nameLen > remaining)
+                    throwMatError(_fileName, "The file is truncated or corrupt.");
+                remaining -= nameLen;
+                if (0 != mrows && ncols > remaining / valueSize / mrows)
+                    throwMatError(_fileName, "The file is truncated or corrupt.");
+
+                const char* name = _data + offset + 20;
+                const char* block = name + nameLen;
+                const std::size_t blockSize = mrows * ncols * valueSize;
+
+                const std::string matName(name, nameLen - 1);
+                if ("Aclass" == matName)
+                {
+                    // The fourth row tells if the following matrices are stored transposed ("binTrans").
+                    std::string storage;
+                    for (std::size_t c = 0; c < ncols && 3 < mrows; ++c)
+                        storage += block[3 + c * mrows];
+                    transposed = (0 == storage.compare(0, 8, "binTrans"));
+                }
+                else if ("name" == matName)
+                {
+                    names = block;
+                    nameRows = mrows;
+                    nameCols = ncols;
+                }
+                else if ("dataInfo" == matName)
+                {
+                    // Every variable has four int32 fields.
+                    if (20 != type || 4 > (transposed ? mrows : ncols))
+                        throwMatError(_fileName, "The matrix dataInfo is corrupt.");
+                    _dataInfo = block;
+                    numInfoVars = transposed ? ncols : mrows;
+                    _infoVarStride = transposed ? 4 : 1;
+                    _infoFieldStride = transposed ? 1 : mrows;
+                }
+                else if ("data_1" == matName)
+                {
+                    _data1 = block;
+                    _data1ValueSize = valueSize;
+                    _numParams = transposed ? mrows : ncols;
+                    _data1VarStride = transposed ? 1 : mrows;
+                }
+                else if ("data_2" == matName)
+                {
+                    _data2 = block;
+                    _data2ValueSize = valueSize;
+                    _numVars = transposed ? mrows : ncols;
+                    _numRows = transposed ? ncols : mrows;
+                    _data2VarStride = transposed ? 1 : mrows;
+                    _data2RowStride = transposed ? mrows : 1;
+                }
+                offset += 20 + nameLen + blockSize;
+            }
+
+            if (nullptr == names || nullptr == _dataInfo || nullptr == _data2 || 0 == _numRows || 0 == _numVars)
+                throwMatError(_fileName, "The file does not contain an OpenModelica result.");
+            if (8 != _data2ValueSize && 4 != _data2ValueSize)
+                throwMatError(_fileName, "data_2 is neither stored in single nor in double precision.");
+            if (nullptr != _data1 && 8 != _data1ValueSize && 4 != _data1ValueSize)
+                throwMatError(_fileName, "data_1 is neither stored in single nor in double precision.");
+
+            // Index the variable names. Names are blank or zero padded to the longest name.
+            const std::size_t numNames = transposed ? nameCols : nameRows;
+            const std::size_t maxLen = transposed ? nameRows : nameCols;
+            const std::size_t charStride = transposed ? 1 : nameRows;
+            const std::size_t nameStride = transposed ? nameRows : 1;
+            if (numNames != numInfoVars)
+                throwMatError(_fileName, "The matrices name and dataInfo do not match.");
+
+            _varIndices.reserve((nullptr == varNames) ? numNames : varNames->size());
+            std::string varName;
+            for (std::size_t i = 0; i < numNames; ++i)
+            {
+                varName.clear();
+                for (std::size_t k = 0; k < maxLen; ++k)
+                {
+                    const char c = names[i * nameStride + k * charStride];
+                    if ('\0' == c)
+                        break;
+                    varName += c;
+                }
+                while (!varName.empty() && ' ' == varName.back())
+                    varName.pop_back();
+                if (nullptr == varNames || 0u != varNames->count(varName))
+                    _varIndices.emplace(varName, i);
+            }
+
+            // The first variable of data_2 is the time.
+            _rowBytes = _data2RowStride * _data2ValueSize;
+            _time.base = _data2;
+            _time.rowStride = _rowBytes;
+            _time.sign = 1.0;
+            _time.isDouble = (8 == _data2ValueSize);
+            _cursor.row = 0;
+            _cursor.weight = 0.0;
+        }
+
+        void MatResultFile::loadSelectedColumns()
+        {
+            // Collect the data_2 columns of all indexed variables. Aliases share the column of their target, thus
+            // every column is decoded only once. The time is always the first column.
+            std::vector<std::size_t> columns(1, 0);
+            _selectedColumns.clear();
+            _selectedColumns.emplace(0, 0);
+            for (const auto& var : _varIndices)
+            {
+                const std::int32_t dataSet = readInt32(_dataInfo + 4 * var.second * _infoVarStride);
+                const std::int32_t colIdx = readInt32(_dataInfo + 4 * (var.second * _infoVarStride + _infoFieldStride));
+                if (1 == dataSet || 0 == colIdx)
+                    continue;
+
+                const std::size_t col = static_cast<std::size_t>(0 > colIdx ? -colIdx : colIdx) - 1;
+                if (col < _numVars && _selectedColumns.emplace(col, columns.size()).second)
+                    columns.push_back(col);
+            }
+
+            // Decode row by row and release the mapped pages behind us. Only the pages containing one of the
+            // selected columns are read from disk at all.
+            const std::size_t numCols = columns.size();
+            const std::size_t rowBytes = _data2RowStride * _data2ValueSize;
+            _selectedRows.resize(_numRows * numCols);
+            double* dst = _selectedRows.data();
+            std::size_t released = 0;
+            for (std::size_t row = 0; row < _numRows; ++row)
+            {
+                const char* src = _data2 + row * rowBytes;
+                for (std::size_t j = 0; j < numCols; ++j)
+                {
+                    const char* ptr = src + columns[j] * _data2VarStride * _data2ValueSize;
+                    if (8 == _data2ValueSize)
+                    {
+                        std::memcpy(dst, ptr, sizeof(double));
+                    }
+                    else
+                    {
+                        float val;
+                        std::memcpy(&val, ptr, sizeof(float));
+                        *dst = val;
+                    }
+                    ++dst;
+                }
+
+                if (1 == _data2VarStride && row + 1 - released >= releaseRows)
+                {
+                    _file.release(_data2 + released * rowBytes, _data2 + (row + 1) * rowBytes);
+                    released = row + 1;
+                }
+            }
+            _file.release(_data2, _data2 + _numRows * _numVars * _data2ValueSize);
+
+            // From now on, time dependent variables are read from the decoded table.
+            _rowBytes = numCols * sizeof(double);
+            _time.base = reinterpret_cast<const char*>(_selectedRows.data());
+            _time.rowStride = _rowBytes;
+            _time.isDouble = true;
+        }
+
+    }  // namespace Model
+}  // namespace OMVIS
@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/NodeUpdater.hpp"
+#include "Model/Shapes/Spring.hpp"
+#include "Model/Shapes/Pipecylinder.hpp"
+
+#include <osg/Material>
+
+#include <algorithm>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        namespace
+        {
+            /*! \brief Replaces the drawable of the shape by the given one. */
+            void replaceDrawable(ShapeNodes& nodes, osg::Drawable* draw)
+            {
+                nodes.geode->setDrawable(0, draw);
+                nodes.drawable = draw;
+            }
+
+            /*! \brief Updates the geometry of a shape of the given type.
+             *
+             * The primary template handles the primitives, CAD files and unknown types. The primitives share one
+             * drawable at unit size per type, see \ref OSGScene::setUpScene. Their size is part of the matrix of the
+             * shape. Thus, there is nothing to do.
+             */
+            template <ShapeType T>
+            struct GeometryUpdate
+            {
+                static void apply(ShapeNodes& /*nodes*/, const ShapeObject& /*shape*/, GeometryCache& /*cache*/)
+                {
+                }
+            };
+
+            /*! \brief Pipe cylinders are taken from the cache. If only the length changes, the shape gets a private
+             *         geometry, which is updated in place from then on.
+             */
+            template <>
+            struct GeometryUpdate<ShapeType::PIPECYLINDER>
+            {
+                static void apply(ShapeNodes& nodes, const ShapeObject& shape, GeometryCache& cache)
+                {
+                    const float rI = (shape._width.exp * shape._extra.exp) / 2;
+                    const float rO = shape._width.exp / 2;
+                    const float l = shape._length.exp;
+
+                    Pipecylinder* pipe = dynamic_cast<Pipecylinder*>(nodes.drawable);
+                    if (nullptr != pipe && GeometryCache::equal(rI, pipe->getInnerRadius())
+                            && GeometryCache::equal(rO, pipe->getOuterRadius()))
+                    {
+                        if (GeometryCache::equal(l, pipe->getLength()))
+                            return;
+
+                        if (osg::Object::DYNAMIC == pipe->getDataVariance())
+                        {
+                            pipe->setLength(l);
+                            return;
+                        }
+                        pipe = new Pipecylinder(rI, rO, l);
+                        pipe->setDataVariance(osg::Object::DYNAMIC);
+                        replaceDrawable(nodes, pipe);
+                        return;
+                    }
+                    replaceDrawable(nodes, cache.getPipecylinder(rI, rO, l));
+                }
+            };
+
+            template <>
+            struct GeometryUpdate<ShapeType::PIPE> : GeometryUpdate<ShapeType::PIPECYLINDER>
+            {
+            };
+
+            /*! \brief Springs are handled like pipe cylinders. */
+            template <>
+            struct GeometryUpdate<ShapeType::SPRING>
+            {
+                static void apply(ShapeNodes& nodes, const ShapeObject& shape, GeometryCache& cache)
+                {
+                    const float r = shape._width.exp;
+                    const float rCoil = shape._height.exp;
+                    const float nWindings = shape._extra.exp;
+                    const float l = shape._length.exp;
+
+                    Spring* spring = dynamic_cast<Spring*>(nodes.drawable);
+                    if (nullptr != spring && GeometryCache::equal(r, spring->getRadius())
+                            && GeometryCache::equal(rCoil, spring->getCoilRadius())
+                            && GeometryCache::equal(nWindings, spring->getNumWindings()))
+                    {
+                        if (GeometryCache::equal(l, spring->getLength()))
+                            return;
+
+                        if (osg::Object::DYNAMIC == spring->getDataVariance())
+                        {
+                            spring->setLength(l);
+                            return;
+                        }
+                        spring = new Spring(r, rCoil, nWindings, l);
+                        spring->setDataVariance(osg::Object::DYNAMIC);
+                        replaceDrawable(nodes, spring);
+                        return;
+                    }
+                    replaceDrawable(nodes, cache.getSpring(r, rCoil, nWindings, l));
+                }
+            };
+
+            /*! \brief Returns the color of the shape. */
+            osg::Vec4f getColor(const ShapeObject& shape)
+            {
+                return osg::Vec4f(shape._color[0].exp / 255, shape._color[1].exp / 255, shape._color[2].exp / 255,
+                                  1.0);
+            }
+
+            /*! \brief Sets the color of the material, if it has changed. */
+            void updateMaterial(osg::Material& material, const ShapeObject& shape)
+            {
+                const osg::Vec4f color = getColor(shape);
+                if (material.getDiffuse(osg::Material::FRONT) != color)
+                    material.setDiffuse(osg::Material::FRONT, color);
+            }
+        }
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        NodeUpdater::NodeUpdater()
+                : _geometryCache(),
+                  _changedInstances()
+        {
+            // One primitive per instanced type, thus adding them never allocates during a frame.
+            _changedInstances.reserve(4);
+        }
+
+        /*-----------------------------------------
+         * SIMULATION METHODS
+         *---------------------------------------*/
+
+        void NodeUpdater::update(ShapeNodes& nodes, const ShapeObject& shape)
+        {
+            // Instanced primitives are drawn at unit size, thus only the matrix and the color are needed.
+            if (nullptr != nodes.instances)
+            {
+                nodes.instances->setInstance(nodes.instance, shape._mat, getColor(shape));
+                if (_changedInstances.end()
+                        == std::find(_changedInstances.begin(), _changedInstances.end(), nodes.instances))
+                    _changedInstances.push_back(nodes.instances);
+                return;
+            }
+
+            nodes.transform->setMatrix(shape._mat);
+
+            switch (shape._shapeType)
+            {
+                case ShapeType::PIPE:
+                    GeometryUpdate<ShapeType::PIPE>::apply(nodes, shape, _geometryCache);
+                    break;
+                case ShapeType::PIPECYLINDER:
+                    GeometryUpdate<ShapeType::PIPECYLINDER>::apply(nodes, shape, _geometryCache);
+                    break;
+                case ShapeType::SPRING:
+                    GeometryUpdate<ShapeType::SPRING>::apply(nodes, shape, _geometryCache);
+                    break;
+                default:
+                    // The geometry of all other types does not change.
+                    break;
+            }
+
+            if (nullptr != nodes.material)
+                updateMaterial(*nodes.material, shape);
+        }
+
+        void NodeUpdater::finishFrame()
+        {
+            for (InstancedPrimitive* primitive : _changedInstances)
+                primitive->dirtyInstances();
+            _changedInstances.clear();
+        }
+
+    }  // namespace Model
+}  // namespace OMVIS
@@ -22,17 +22,144 @@
 #include "Util/Logger.hpp"
 #include "Util/Util.hpp"
 #include "Model/Shapes/DXFile.hpp"
+#include "Model/Shapes/Pipecylinder.hpp"
+#include "Model/Shapes/Spring.hpp"
 
 #include <osg/MatrixTransform>
 #include <osg/ShapeDrawable>
 #include <osg/Material>
+#include <osg/Version>
 #include <osgDB/ReadFile>
+#include <osgUtil/Optimizer>
+
+#include <map>
 
 namespace OMVIS
 {
     namespace Model
     {
 
+        namespace
+        {
+            /*! \brief Creates a primitive at unit size, which is scaled by the matrix of the shape.
+             *
+             * Unknown types get a capsule, which is not scaled. Pipes and springs do not have a unit primitive.
+             */
+            osg::Shape* createUnitShape(const ShapeType type)
+            {
+                const osg::Vec3f center(0.0, 0.0, 0.0);
+                switch (type)
+                {
+                    case ShapeType::BOX:
+                        return new osg::Box(center, 1.0);
+                    case ShapeType::CYLINDER:
+                        return new osg::Cylinder(center, 0.5, 1.0);
+                    case ShapeType::CONE:
+                        return new osg::Cone(center, 0.5, 1.0);
+                    case ShapeType::SPHERE:
+                        return new osg::Sphere(center, 0.5);
+                    case ShapeType::PIPE:
+                    case ShapeType::PIPECYLINDER:
+                    case ShapeType::SPRING:
+                        return nullptr;
+                    default:
+                        return new osg::Capsule(center, 0.1, 0.5);
+                }
+            }
+
+            /*! \brief Creates the drawable of a primitive at unit size, which is shared by all shapes of this type.
+             *
+             * Pipes and springs get an empty drawable, which is replaced by the \ref NodeUpdater.
+             */
+            osg::ShapeDrawable* createUnitDrawable(const ShapeType type)
+            {
+                auto shapeDraw = new osg::ShapeDrawable();
+                osg::Shape* shape = createUnitShape(type);
+                if (nullptr != shape)
+                    shapeDraw->setShape(shape);
+                shapeDraw->setColor(osg::Vec4(1.0, 1.0, 1.0, 1.0));
+                return shapeDraw;
+            }
+
+            /*! \brief Returns the color of the shape. */
+            osg::Vec4f getColor(const ShapeObject& shape)
+            {
+                return osg::Vec4f(shape._color[0].exp / 255, shape._color[1].exp / 255, shape._color[2].exp / 255,
+                                  1.0);
+            }
+
+            /*! \brief Creates a material with the color of the shape. */
+            osg::Material* createMaterial(const ShapeObject& shape)
+            {
+                auto material = new osg::Material();
+                material->setDiffuse(osg::Material::FRONT, getColor(shape));
+                return material;
+            }
+
+            /*! \brief Creates the geometry of a constant primitive at unit size with the color of the shape as vertex
+             *         color. Unlike \ref createUnitDrawable, the geometry belongs to this shape only.
+             */
+            osg::Drawable* createStaticDrawable(const ShapeObject& shape)
+            {
+                osg::ref_ptr<osg::Shape> unitShape = createUnitShape(shape._shapeType);
+#if OSG_VERSION_GREATER_OR_EQUAL(3, 5, 6)
+                // Plain geometries can be flattened and merged by the optimizer.
+                return osg::convertShapeToGeometry(*unitShape, nullptr, getColor(shape), osg::Array::BIND_PER_VERTEX);
+#else
+                // Shape drawables are not geometries, thus the optimizer keeps their transforms.
+                auto shapeDraw = new osg::ShapeDrawable(unitShape.get());
+                shapeDraw->setColor(getColor(shape));
+                return shapeDraw;
+#endif
+            }
+
+            /*! \brief Creates the node of a constant shape below a static transformation with the current matrix of the
+             *         shape.
+             *
+             * Primitives carry their color as vertex color, such that they do not need a state set of their own and
+             * can be merged. All other shapes keep their material.
+             */
+            osg::MatrixTransform* createStaticNode(const ShapeObject& shape)
+            {
+                auto transf = new osg::MatrixTransform(shape._mat);
+                transf->setDataVariance(osg::Object::STATIC);
+                osg::ref_ptr<osg::Geode> geode = new osg::Geode();
+                switch (shape._shapeType)
+                {
+                    case ShapeType::STL:
+                    {
+                        osg::ref_ptr<osg::Node> node = osgDB::readNodeFile(shape._fileName);
+                        node->getOrCreateStateSet()->setAttribute(createMaterial(shape), osg::StateAttribute::ON
+                                                                          | osg::StateAttribute::OVERRIDE);
+                        transf->addChild(node.get());
+                        return transf;
+                    }
+                    case ShapeType::DXF:
+                        // DXF files bring their own colors.
+                        geode->addDrawable(new DXFile(shape._fileName));
+                        break;
+                    case ShapeType::PIPE:
+                    case ShapeType::PIPECYLINDER:
+                        geode->addDrawable(new Pipecylinder((shape._width.exp * shape._extra.exp) / 2,
+                                                            shape._width.exp / 2, shape._length.exp));
+                        geode->getOrCreateStateSet()->setAttribute(createMaterial(shape));
+                        break;
+                    case ShapeType::SPRING:
+                        geode->addDrawable(new Spring(shape._width.exp, shape._height.exp, shape._extra.exp,
+                                                      shape._length.exp));
+                        geode->getOrCreateStateSet()->setAttribute(createMaterial(shape));
+                        break;
+                    default:
+                        geode->addDrawable(createStaticDrawable(shape));
+                        break;
+                }
+                transf->addChild(geode.get());
+                return transf;
+            }
+        }
+
+        constexpr std::size_t OSGScene::minInstances;
+
         /*-----------------------------------------
          * CONSTRUCTORS
          *---------------------------------------*/
@@ -47,62 +174,158 @@ namespace OMVIS
          * INITIALIZATION METHODS
          *---------------------------------------*/
 
-        void OSGScene::setUpScene(const std::vector<Model::ShapeObject>& allShapes)
+        std::vector<ShapeNodes> OSGScene::setUpScene(const std::vector<Model::ShapeObject>& allShapes,
+                                                     const std::vector<std::uint32_t>& constShapes)
         {
+            std::vector<ShapeNodes> shapeNodes(allShapes.size(),
+                                               ShapeNodes { nullptr, nullptr, nullptr, nullptr, nullptr, 0 });
             osg::ref_ptr<osg::Geode> geode;
-            osg::ref_ptr<osg::StateSet> ss;
-            std::string type;
             osg::ref_ptr<osg::Material> material(nullptr);
-            osg::Vec4f zeroVec(0.0, 0.0, 0.0, 0.0);
             osg::ref_ptr<osg::MatrixTransform> transf(nullptr);
+            // One drawable per primitive type, shared by all shapes of this type.
+            std::map<ShapeType, osg::ref_ptr<osg::ShapeDrawable>> unitDrawables;
+
+            // The matrices of the primitives contain a scale, thus, the normals have to be normalized.
+            _rootNode->getOrCreateStateSet()->setMode(GL_NORMALIZE, osg::StateAttribute::ON);
+
+            std::vector<bool> isConst(allShapes.size(), false);
+            for (const std::uint32_t shapeIdx : constShapes)
+                isConst[shapeIdx] = true;
+
+            // Primitive types with many non-constant shapes are drawn instanced.
+            std::map<ShapeType, std::size_t> numInstances;
+            for (std::size_t shapeIdx = 0; shapeIdx < allShapes.size(); ++shapeIdx)
+            {
+                if (!isConst[shapeIdx] && InstancedPrimitive::isInstanced(allShapes[shapeIdx]._shapeType))
+                    ++numInstances[allShapes[shapeIdx]._shapeType];
+            }
+            std::map<ShapeType, osg::ref_ptr<InstancedPrimitive>> instancedPrimitives;
+            for (const auto& entry : numInstances)
+            {
+                if (minInstances > entry.second)
+                    continue;
+                osg::ref_ptr<InstancedPrimitive> primitive = new InstancedPrimitive(entry.first, entry.second);
+                geode = new osg::Geode();
+                geode->addDrawable(primitive.get());
+                _rootNode->addChild(geode.get());
+                instancedPrimitives[entry.first] = primitive;
+                LOGGER_WRITE("Draw " + std::to_string(entry.second) + " shapes of type "
+                             + std::to_string(static_cast<int>(entry.first)) + " instanced.", Util::LC_LOADER,
+                             Util::LL_DEBUG);
+            }
+            std::map<ShapeType, std::uint32_t> nextInstance;
 
-            for (auto& shape : allShapes)
+            for (std::size_t shapeIdx = 0; shapeIdx < allShapes.size(); ++shapeIdx)
             {
-                type = shape._type;
-                LOGGER_WRITE("Shape: " + shape._id + std::string(", type: ") + type, Util::LC_LOADER, Util::LL_DEBUG);
+                const ShapeObject& shape = allShapes[shapeIdx];
+                LOGGER_WRITE("Shape: " + shape._id + std::string(", type: ") + shape._type, Util::LC_LOADER,
+                             Util::LL_DEBUG);
+                if (isConst[shapeIdx])
+                    continue;
+
+                auto instanced = instancedPrimitives.find(shape._shapeType);
+                if (instancedPrimitives.end() != instanced)
+                {
+                    ShapeNodes& nodes = shapeNodes[shapeIdx];
+                    nodes.instances = instanced->second.get();
+                    nodes.instance = nextInstance[shape._shapeType]++;
+                    nodes.instances->setInstance(nodes.instance, shape._mat, getColor(shape));
+                    continue;
+                }
 
-                // Color
-                material = new osg::Material();
-                material->setDiffuse(osg::Material::FRONT, zeroVec);
+                // Color. The material is updated by the NodeUpdater, if the color changes.
+                material = createMaterial(shape);
+                if (!shape._color[0].isConst || !shape._color[1].isConst || !shape._color[2].isConst)
+                    material->setDataVariance(osg::Object::DYNAMIC);
 
                 // Matrix transformation
                 transf = new osg::MatrixTransform();
+                ShapeNodes nodes = { transf.get(), nullptr, nullptr, material.get(), nullptr, 0 };
 
-				//cad node
-				if (shape._type.compare("stl") == 0)
-				{
-					//std::cout<<"Its a CAD and the filename is "<<shape._fileName<<std::endl;
-					osg::ref_ptr<osg::Node> node = osgDB::readNodeFile(shape._fileName);
-					osg::ref_ptr<osg::StateSet> ss = node->getOrCreateStateSet();
-
-					ss->setAttribute(material.get());
-					node->setStateSet(ss);
-					transf->addChild(node.get());
-				}
-				else if ((shape._type.compare("dxf") == 0)) {
-					std::string name = shape._fileName;
-					DXFile* shape = new DXFile(name);
-					geode = new osg::Geode();
-					geode->addDrawable(shape);
-					//osg::ref_ptr<osg::StateSet> ss = geode->getOrCreateStateSet();
-					//ss->setAttribute(material.get());
-					//geode->setStateSet(ss);
-					transf->addChild(geode);
-				}
-                // Geode with shape drawable
-                else
+                switch (shape._shapeType)
                 {
-                    auto shapeDraw = new osg::ShapeDrawable();
-                    shapeDraw->setColor(osg::Vec4(1.0, 1.0, 1.0, 1.0));
-                    geode = new osg::Geode();
-                    geode->addDrawable(shapeDraw);
-                    osg::ref_ptr<osg::StateSet> ss = geode->getOrCreateStateSet();
-                    ss->setAttribute(material.get());
-                    geode->setStateSet(ss);
-                    transf->addChild(geode);
+                    // CAD node
+                    case ShapeType::STL:
+                    {
+                        //std::cout<<"Its a CAD and the filename is "<<shape._fileName<<std::endl;
+                        osg::ref_ptr<osg::Node> node = osgDB::readNodeFile(shape._fileName);
+                        osg::ref_ptr<osg::StateSet> ss = node->getOrCreateStateSet();
+
+                        // The geodes of the file must not override the color of the shape.
+                        ss->setAttribute(material.get(), osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE);
+                        node->setStateSet(ss);
+                        transf->addChild(node.get());
+                        break;
+                    }
+                    case ShapeType::DXF:
+                    {
+                        DXFile* dxf = new DXFile(shape._fileName);
+                        geode = new osg::Geode();
+                        geode->addDrawable(dxf);
+                        transf->addChild(geode);
+                        // DXF files bring their own colors.
+                        nodes.geode = geode.get();
+                        nodes.drawable = dxf;
+                        nodes.material = nullptr;
+                        break;
+                    }
+                    // Geode with shape drawable
+                    default:
+                    {
+                        osg::ref_ptr<osg::ShapeDrawable>& shapeDraw = unitDrawables[shape._shapeType];
+                        if (!shapeDraw)
+                            shapeDraw = createUnitDrawable(shape._shapeType);
+                        geode = new osg::Geode();
+                        geode->addDrawable(shapeDraw.get());
+                        osg::ref_ptr<osg::StateSet> ss = geode->getOrCreateStateSet();
+                        ss->setAttribute(material.get());
+                        geode->setStateSet(ss);
+                        transf->addChild(geode);
+                        nodes.geode = geode.get();
+                        nodes.drawable = shapeDraw.get();
+                        break;
+                    }
                 }
                 _rootNode->addChild(transf.get());
+                shapeNodes[shapeIdx] = nodes;
             }
+
+            for (const auto& entry : instancedPrimitives)
+                entry.second->dirtyInstances();
+
+            if (!constShapes.empty())
+                _rootNode->addChild(createStaticScene(allShapes, constShapes));
+            return shapeNodes;
+        }
+
+        /*-----------------------------------------
+         * PRIVATE METHODS
+         *---------------------------------------*/
+
+        osg::ref_ptr<osg::Group> OSGScene::createStaticScene(const std::vector<Model::ShapeObject>& allShapes,
+                                                             const std::vector<std::uint32_t>& constShapes) const
+        {
+            osg::ref_ptr<osg::Group> staticScene = new osg::Group();
+            staticScene->setDataVariance(osg::Object::STATIC);
+            for (const std::uint32_t shapeIdx : constShapes)
+                staticScene->addChild(createStaticNode(allShapes[shapeIdx]));
+
+            // The vertex colors of the primitives replace their materials.
+            osg::ref_ptr<osg::Material> material = new osg::Material();
+            material->setColorMode(osg::Material::DIFFUSE);
+            staticScene->getOrCreateStateSet()->setAttribute(material.get());
+
+            // Move the matrices into the vertices, remove the then empty transformations and merge the primitives into
+            // as few geometries as possible.
+            osgUtil::Optimizer optimizer;
+            optimizer.optimize(staticScene.get(), osgUtil::Optimizer::FLATTEN_STATIC_TRANSFORMS
+                                       | osgUtil::Optimizer::REMOVE_REDUNDANT_NODES
+                                       | osgUtil::Optimizer::MERGE_GEODES
+                                       | osgUtil::Optimizer::MERGE_GEOMETRY
+                                       | osgUtil::Optimizer::SHARE_DUPLICATE_STATE);
+            LOGGER_WRITE("Merged " + std::to_string(constShapes.size()) + " constant shapes into a static scene with "
+                         + std::to_string(staticScene->getNumChildren()) + " nodes.", Util::LC_LOADER, Util::LL_DEBUG);
+            return staticScene;
         }
 
         /*-----------------------------------------
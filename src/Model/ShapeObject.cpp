@@ -19,6 +19,7 @@
 
 #include "Model/ShapeObject.hpp"
 #include "Util/Visualize.hpp"
+#include "Util/Util.hpp"
 
 #include <iostream>
 
@@ -34,6 +35,7 @@ namespace OMVIS
         ShapeObject::ShapeObject()
                 : _id("noID"),
                   _type("box"),
+                  _shapeType(ShapeType::BOX),
                   _fileName("noFile"),
                   _length(0.1),
                   _width(0.1),
@@ -55,6 +57,24 @@ namespace OMVIS
         {
         }
 
+        /*-----------------------------------------
+         * GETTERS AND SETTERS
+         *---------------------------------------*/
+
+        constexpr std::size_t ShapeObject::numAttributes;
+
+        std::array<ShapeObjectAttribute*, ShapeObject::numAttributes> ShapeObject::getAttributes()
+        {
+            return {{ &_length, &_width, &_height,
+                      &_lDir[0], &_lDir[1], &_lDir[2],
+                      &_wDir[0], &_wDir[1], &_wDir[2],
+                      &_r[0], &_r[1], &_r[2],
+                      &_rShape[0], &_rShape[1], &_rShape[2],
+                      &_T[0], &_T[1], &_T[2], &_T[3], &_T[4], &_T[5], &_T[6], &_T[7], &_T[8],
+                      &_color[0], &_color[1], &_color[2],
+                      &_specCoeff, &_extra }};
+        }
+
         /*-----------------------------------------
          * PRINT METHODS
          *---------------------------------------*/
@@ -91,5 +111,35 @@ namespace OMVIS
                       << "\n  extra: \t" << _extra.getValueString() << std::endl;
         }
 
+        /*-----------------------------------------
+         * FREE METHODS
+         *---------------------------------------*/
+
+        ShapeType getShapeTypeForString(const std::string& typeString)
+        {
+            if (0 == typeString.compare("box"))
+                return ShapeType::BOX;
+            if (0 == typeString.compare("cylinder"))
+                return ShapeType::CYLINDER;
+            if (0 == typeString.compare("cone"))
+                return ShapeType::CONE;
+            if (0 == typeString.compare("sphere"))
+                return ShapeType::SPHERE;
+            if (0 == typeString.compare("pipe"))
+                return ShapeType::PIPE;
+            if (0 == typeString.compare("pipecylinder"))
+                return ShapeType::PIPECYLINDER;
+            if (0 == typeString.compare("spring"))
+                return ShapeType::SPRING;
+            if (0 == typeString.compare("stl"))
+                return ShapeType::STL;
+            if (0 == typeString.compare("dxf"))
+                return ShapeType::DXF;
+            if (Util::isCADType(typeString))
+                return ShapeType::CAD;
+
+            return ShapeType::UNKNOWN;
+        }
+
     }  // namespace Model
 }  // namespace OMVIS
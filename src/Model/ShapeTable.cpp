@@ -0,0 +1,312 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/ShapeTable.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <unordered_map>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        ShapeTable::ShapeTable()
+                : _numShapes(0),
+                  _values(),
+                  _coefficients(),
+                  _matrices(),
+                  _constMasks(),
+                  _dynamicSlots(),
+                  _dynamicAttrs(),
+                  _dynamicVariables(),
+                  _dynamicShapeIndices(),
+                  _constShapes(),
+                  _dynamicShapes(),
+                  _dirty(),
+                  _variables(),
+                  _variableValues()
+        {
+        }
+
+        /*-----------------------------------------
+         * INITIALIZATION METHODS
+         *---------------------------------------*/
+
+        void ShapeTable::build(std::vector<ShapeObject>& shapes)
+        {
+            clear();
+            _numShapes = shapes.size();
+            _values.resize(ShapeObject::numAttributes * _numShapes);
+            _coefficients.resize(Util::TC_NUM * _numShapes);
+            _matrices.resize(16 * _numShapes);
+            _constMasks.resize(_numShapes);
+
+            std::unordered_map<std::string, std::uint32_t> varIndices;
+            for (std::size_t shapeIdx = 0; shapeIdx < _numShapes; ++shapeIdx)
+            {
+                float coefficients[Util::TC_NUM];
+                Util::getTransformCoefficients(shapes[shapeIdx]._shapeType, coefficients);
+                for (std::size_t coeffIdx = 0; coeffIdx < Util::TC_NUM; ++coeffIdx)
+                    _coefficients[coeffIdx * _numShapes + shapeIdx] = coefficients[coeffIdx];
+
+                auto attrs = shapes[shapeIdx].getAttributes();
+                for (std::size_t attrIdx = 0; attrIdx < ShapeObject::numAttributes; ++attrIdx)
+                {
+                    const std::size_t slot = attrIdx * _numShapes + shapeIdx;
+                    _values[slot] = attrs[attrIdx]->exp;
+                    if (attrs[attrIdx]->isConst)
+                    {
+                        _constMasks[shapeIdx].set(attrIdx);
+                    }
+                    else
+                    {
+                        auto var = varIndices.emplace(attrs[attrIdx]->cref,
+                                                      static_cast<std::uint32_t>(_variables.size()));
+                        if (var.second)
+                            _variables.push_back(attrs[attrIdx]->cref);
+                        _dynamicSlots.push_back(static_cast<std::uint32_t>(slot));
+                        _dynamicAttrs.push_back(attrs[attrIdx]);
+                        _dynamicVariables.push_back(var.first->second);
+                        _dynamicShapeIndices.push_back(static_cast<std::uint32_t>(shapeIdx));
+                    }
+                }
+            }
+            _variableValues.resize(_variables.size());
+            _dirty.assign(_numShapes, 1);
+            collectShapes();
+        }
+
+        void ShapeTable::clear()
+        {
+            _numShapes = 0;
+            _values.clear();
+            _coefficients.clear();
+            _matrices.clear();
+            _constMasks.clear();
+            _dynamicSlots.clear();
+            _dynamicAttrs.clear();
+            _dynamicVariables.clear();
+            _dynamicShapeIndices.clear();
+            _constShapes.clear();
+            _dynamicShapes.clear();
+            _dirty.clear();
+            _variables.clear();
+            _variableValues.clear();
+        }
+
+        void ShapeTable::makeConst(const std::vector<std::size_t>& varIndices, const float value)
+        {
+            if (varIndices.empty())
+                return;
+
+            // Compact the variable table and remember the new position of every variable.
+            const std::uint32_t removed = std::numeric_limits<std::uint32_t>::max();
+            std::vector<std::uint32_t> newIndices(_variables.size());
+            std::size_t next = 0;
+            std::uint32_t keptVars = 0;
+            for (std::size_t i = 0; i < _variables.size(); ++i)
+            {
+                if (next < varIndices.size() && i == varIndices[next])
+                {
+                    newIndices[i] = removed;
+                    ++next;
+                }
+                else
+                {
+                    newIndices[i] = keptVars;
+                    _variables[keptVars++] = std::move(_variables[i]);
+                }
+            }
+            _variables.resize(keptVars);
+            _variableValues.resize(keptVars);
+
+            std::size_t kept = 0;
+            for (std::size_t i = 0; i < _dynamicAttrs.size(); ++i)
+            {
+                const std::uint32_t varIdx = newIndices[_dynamicVariables[i]];
+                if (removed == varIdx)
+                {
+                    const std::uint32_t slot = _dynamicSlots[i];
+                    _values[slot] = value;
+                    _constMasks[slot % _numShapes].set(slot / _numShapes);
+                    _dynamicAttrs[i]->isConst = true;
+                    _dynamicAttrs[i]->exp = value;
+                }
+                else
+                {
+                    _dynamicSlots[kept] = _dynamicSlots[i];
+                    _dynamicAttrs[kept] = _dynamicAttrs[i];
+                    _dynamicVariables[kept] = varIdx;
+                    _dynamicShapeIndices[kept] = _dynamicShapeIndices[i];
+                    ++kept;
+                }
+            }
+            _dynamicSlots.resize(kept);
+            _dynamicAttrs.resize(kept);
+            _dynamicVariables.resize(kept);
+            _dynamicShapeIndices.resize(kept);
+            collectShapes();
+        }
+
+        /*-----------------------------------------
+         * GETTERS and SETTERS
+         *---------------------------------------*/
+
+        std::size_t ShapeTable::getNumShapes() const
+        {
+            return _numShapes;
+        }
+
+        std::size_t ShapeTable::getNumDynamic() const
+        {
+            return _dynamicAttrs.size();
+        }
+
+        std::size_t ShapeTable::getNumVariables() const
+        {
+            return _variables.size();
+        }
+
+        const std::string& ShapeTable::getVariable(const std::size_t varIdx) const
+        {
+            return _variables[varIdx];
+        }
+
+        float* ShapeTable::getVariableValues()
+        {
+            return _variableValues.data();
+        }
+
+        const float* ShapeTable::getValues(const std::size_t attrIdx) const
+        {
+            return _values.data() + attrIdx * _numShapes;
+        }
+
+        Util::TransformInputs ShapeTable::getTransformInputs() const
+        {
+            Util::TransformInputs in;
+            for (std::size_t k = 0; k < 3; ++k)
+            {
+                in.r[k] = getValues(SA_R + k);
+                in.rShape[k] = getValues(SA_RSHAPE + k);
+                in.lDir[k] = getValues(SA_LDIR + k);
+                in.wDir[k] = getValues(SA_WDIR + k);
+            }
+            for (std::size_t k = 0; k < 9; ++k)
+                in.T[k] = getValues(SA_T + k);
+            in.length = getValues(SA_LENGTH);
+            in.width = getValues(SA_WIDTH);
+            in.height = getValues(SA_HEIGHT);
+            for (std::size_t k = 0; k < Util::TC_NUM; ++k)
+                in.coefficients[k] = _coefficients.data() + k * _numShapes;
+            return in;
+        }
+
+        double* ShapeTable::getMatrices()
+        {
+            return _matrices.data();
+        }
+
+        bool ShapeTable::isConst(const std::size_t shapeIdx, const std::size_t attrIdx) const
+        {
+            return _constMasks[shapeIdx].test(attrIdx);
+        }
+
+        bool ShapeTable::isConstShape(const std::size_t shapeIdx) const
+        {
+            return _constMasks[shapeIdx].all();
+        }
+
+        const std::vector<std::uint32_t>& ShapeTable::getConstShapes() const
+        {
+            return _constShapes;
+        }
+
+        const std::vector<std::uint32_t>& ShapeTable::getDynamicShapes() const
+        {
+            return _dynamicShapes;
+        }
+
+        bool ShapeTable::isDirty(const std::size_t shapeIdx) const
+        {
+            return 0 != _dirty[shapeIdx];
+        }
+
+        void ShapeTable::setDirty(const std::size_t shapeIdx)
+        {
+            _dirty[shapeIdx] = 1;
+        }
+
+        void ShapeTable::clearDirty()
+        {
+            std::fill(_dirty.begin(), _dirty.end(), 0);
+        }
+
+        /*-----------------------------------------
+         * SIMULATION METHODS
+         *---------------------------------------*/
+
+        void ShapeTable::scatter()
+        {
+            for (std::size_t i = 0; i < _dynamicAttrs.size(); ++i)
+            {
+                const float value = _variableValues[_dynamicVariables[i]];
+                float& old = _values[_dynamicSlots[i]];
+                if (old != value)
+                {
+                    old = value;
+                    _dynamicAttrs[i]->exp = value;
+                    _dirty[_dynamicShapeIndices[i]] = 1;
+                }
+            }
+        }
+
+        void ShapeTable::invalidateValues()
+        {
+            // NaN compares unequal to every value.
+            for (const std::uint32_t slot : _dynamicSlots)
+                _values[slot] = std::numeric_limits<float>::quiet_NaN();
+        }
+
+        /*-----------------------------------------
+         * PRIVATE METHODS
+         *---------------------------------------*/
+
+        void ShapeTable::collectShapes()
+        {
+            _constShapes.clear();
+            _dynamicShapes.clear();
+            for (std::size_t shapeIdx = 0; shapeIdx < _numShapes; ++shapeIdx)
+            {
+                if (isConstShape(shapeIdx))
+                    _constShapes.push_back(static_cast<std::uint32_t>(shapeIdx));
+                else
+                    _dynamicShapes.push_back(static_cast<std::uint32_t>(shapeIdx));
+            }
+        }
+
+    }  // namespace Model
+}  // namespace OMVIS
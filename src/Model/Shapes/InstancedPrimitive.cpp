@@ -0,0 +1,331 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/Shapes/InstancedPrimitive.hpp"
+
+#include <osg/Program>
+#include <osg/Shader>
+#include <osg/VertexAttribDivisor>
+
+#define _USE_MATH_DEFINES // for C++
+#include <cmath>
+#include <math.h>
+
+#include <algorithm>
+#include <string>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        namespace
+        {
+            //! Number of edges of the circles of cylinders, cones and spheres.
+            const unsigned int numEdges = 24;
+            //! Number of rings of spheres.
+            const unsigned int numRings = 12;
+
+            const char* vertexShader = R"(
+                #version 120
+                attribute vec4 instanceData0;
+                attribute vec4 instanceData1;
+                attribute vec4 instanceData2;
+                attribute vec4 instanceData3;
+
+                // The rows of the matrix are orthogonal, thus dividing them by their squared length yields the rows
+                // of the inverse transpose.
+                vec3 normalRow(vec3 row)
+                {
+                    return row / max(dot(row, row), 1.e-12);
+                }
+
+                void main()
+                {
+                    vec3 position = gl_Vertex.x * instanceData0.xyz + gl_Vertex.y * instanceData1.xyz
+                            + gl_Vertex.z * instanceData2.xyz + instanceData3.xyz;
+                    gl_Position = gl_ModelViewProjectionMatrix * vec4(position, 1.0);
+
+                    vec3 normal = gl_Normal.x * normalRow(instanceData0.xyz)
+                            + gl_Normal.y * normalRow(instanceData1.xyz) + gl_Normal.z * normalRow(instanceData2.xyz);
+                    normal = normalize(gl_NormalMatrix * normal);
+
+                    // Directional lights, like the headlight of the viewer, have w = 0.
+                    vec4 eyePosition = gl_ModelViewMatrix * vec4(position, 1.0);
+                    vec4 lightPosition = gl_LightSource[0].position;
+                    vec3 light = normalize(lightPosition.xyz - lightPosition.w * eyePosition.xyz);
+
+                    // The color of the instance replaces the diffuse color of the material, like the materials of
+                    // the other shapes do.
+                    vec3 color = vec3(instanceData0.w, instanceData1.w, instanceData2.w);
+                    vec4 ambient = gl_FrontLightModelProduct.sceneColor
+                            + gl_FrontMaterial.ambient * gl_LightSource[0].ambient;
+                    vec4 diffuse = gl_LightSource[0].diffuse * max(dot(normal, light), 0.0);
+                    gl_FrontColor = vec4(ambient.rgb + color * diffuse.rgb, instanceData3.w);
+                }
+            )";
+
+            const char* fragmentShader = R"(
+                #version 120
+                void main()
+                {
+                    gl_FragColor = gl_Color;
+                }
+            )";
+
+            /*! \brief Collects the triangles of a primitive. */
+            class Mesh
+            {
+             public:
+                Mesh(osg::Vec3Array& vertices, osg::Vec3Array& normals, osg::DrawElementsUInt& indices)
+                        : _vertices(vertices),
+                          _normals(normals),
+                          _indices(indices)
+                {
+                }
+
+                unsigned int addVertex(const osg::Vec3& vertex, const osg::Vec3& normal)
+                {
+                    _vertices.push_back(vertex);
+                    _normals.push_back(normal);
+                    return static_cast<unsigned int>(_vertices.size() - 1);
+                }
+
+                /*! \brief Adds the quad a, b, c, d, which is counter-clockwise seen from outside. */
+                void addQuad(const unsigned int a, const unsigned int b, const unsigned int c, const unsigned int d)
+                {
+                    for (const unsigned int idx : { a, b, c, a, c, d })
+                        _indices.push_back(idx);
+                }
+
+                /*! \brief Adds the lateral surface of a cylinder or cone between the heights z0 and z1. */
+                void addLateral(const float z0, const float r0, const float z1, const float r1)
+                {
+                    const unsigned int first = static_cast<unsigned int>(_vertices.size());
+                    const float slope = (r0 - r1) / (z1 - z0);
+                    for (unsigned int i = 0; i <= numEdges; ++i)
+                    {
+                        const double phi = 2.0 * M_PI * i / numEdges;
+                        osg::Vec3 normal(std::cos(phi), std::sin(phi), slope);
+                        normal.normalize();
+                        addVertex(osg::Vec3(r0 * std::cos(phi), r0 * std::sin(phi), z0), normal);
+                        addVertex(osg::Vec3(r1 * std::cos(phi), r1 * std::sin(phi), z1), normal);
+                    }
+                    for (unsigned int i = 0; i < numEdges; ++i)
+                    {
+                        const unsigned int bottom = first + 2 * i;
+                        addQuad(bottom, bottom + 2, bottom + 3, bottom + 1);
+                    }
+                }
+
+                /*! \brief Adds a disc at the height z, which faces up or down. */
+                void addDisc(const float z, const float r, const bool up)
+                {
+                    const osg::Vec3 normal(0.0, 0.0, up ? 1.0 : -1.0);
+                    const unsigned int center = addVertex(osg::Vec3(0.0, 0.0, z), normal);
+                    for (unsigned int i = 0; i <= numEdges; ++i)
+                    {
+                        const double phi = 2.0 * M_PI * i / numEdges;
+                        addVertex(osg::Vec3(r * std::cos(phi), r * std::sin(phi), z), normal);
+                    }
+                    for (unsigned int i = 1; i <= numEdges; ++i)
+                    {
+                        for (const unsigned int idx : { center, up ? center + i : center + i + 1,
+                                                        up ? center + i + 1 : center + i })
+                            _indices.push_back(idx);
+                    }
+                }
+
+                /*! \brief Adds the box [-0.5, 0.5]^3. */
+                void addBox()
+                {
+                    for (int axis = 0; axis < 3; ++axis)
+                    {
+                        for (const float sign : { -1.0f, 1.0f })
+                        {
+                            osg::Vec3 normal, u, v;
+                            normal[axis] = sign;
+                            u[(axis + 1) % 3] = 0.5;
+                            v[(axis + 2) % 3] = 0.5;
+                            if (0.0 > sign)
+                                std::swap(u, v);
+                            const osg::Vec3 center = normal * 0.5;
+                            const unsigned int a = addVertex(center - u - v, normal);
+                            const unsigned int b = addVertex(center + u - v, normal);
+                            const unsigned int c = addVertex(center + u + v, normal);
+                            const unsigned int d = addVertex(center - u + v, normal);
+                            addQuad(a, b, c, d);
+                        }
+                    }
+                }
+
+                /*! \brief Adds the sphere with radius 0.5 around the origin. */
+                void addSphere()
+                {
+                    const unsigned int first = static_cast<unsigned int>(_vertices.size());
+                    for (unsigned int ring = 0; ring <= numRings; ++ring)
+                    {
+                        const double theta = M_PI * ring / numRings;
+                        for (unsigned int i = 0; i <= numEdges; ++i)
+                        {
+                            const double phi = 2.0 * M_PI * i / numEdges;
+                            const osg::Vec3 normal(std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi),
+                                                   std::cos(theta));
+                            addVertex(normal * 0.5, normal);
+                        }
+                    }
+                    for (unsigned int ring = 0; ring < numRings; ++ring)
+                    {
+                        for (unsigned int i = 0; i < numEdges; ++i)
+                        {
+                            const unsigned int upper = first + ring * (numEdges + 1) + i;
+                            const unsigned int lower = upper + numEdges + 1;
+                            addQuad(lower, lower + 1, upper + 1, upper);
+                        }
+                    }
+                }
+
+             private:
+                osg::Vec3Array& _vertices;
+                osg::Vec3Array& _normals;
+                osg::DrawElementsUInt& _indices;
+            };
+        }
+
+        constexpr unsigned int InstancedPrimitive::firstAttribute;
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        InstancedPrimitive::InstancedPrimitive(const ShapeType type, const std::size_t numInstances)
+                : osg::Geometry(),
+                  _numInstances(numInstances),
+                  _unitBound(),
+                  _instanceData()
+        {
+            // The same unit primitives as the shape drawables of OSGScene, e.g., the base of a cone is at -0.25.
+            osg::ref_ptr<osg::Vec3Array> vertices = new osg::Vec3Array();
+            osg::ref_ptr<osg::Vec3Array> normals = new osg::Vec3Array();
+            osg::ref_ptr<osg::DrawElementsUInt> indices = new osg::DrawElementsUInt(osg::PrimitiveSet::TRIANGLES);
+            Mesh mesh(*vertices, *normals, *indices);
+            switch (type)
+            {
+                case ShapeType::BOX:
+                    mesh.addBox();
+                    break;
+                case ShapeType::CYLINDER:
+                    mesh.addLateral(-0.5, 0.5, 0.5, 0.5);
+                    mesh.addDisc(-0.5, 0.5, false);
+                    mesh.addDisc(0.5, 0.5, true);
+                    break;
+                case ShapeType::CONE:
+                    mesh.addLateral(-0.25, 0.5, 0.75, 0.0);
+                    mesh.addDisc(-0.25, 0.5, false);
+                    break;
+                case ShapeType::SPHERE:
+                    mesh.addSphere();
+                    break;
+                default:
+                    break;
+            }
+            for (const auto& vertex : *vertices)
+                _unitBound.expandBy(vertex);
+
+            setVertexArray(vertices.get());
+            setNormalArray(normals.get(), osg::Array::BIND_PER_VERTEX);
+            indices->setNumInstances(numInstances);
+            addPrimitiveSet(indices.get());
+
+            osg::ref_ptr<osg::Program> program = new osg::Program();
+            program->addShader(new osg::Shader(osg::Shader::VERTEX, vertexShader));
+            program->addShader(new osg::Shader(osg::Shader::FRAGMENT, fragmentShader));
+            osg::StateSet* stateSet = getOrCreateStateSet();
+            stateSet->setAttributeAndModes(program.get());
+            for (unsigned int k = 0; k < 4; ++k)
+            {
+                _instanceData[k] = new osg::Vec4Array(numInstances);
+                _instanceData[k]->setDataVariance(osg::Object::DYNAMIC);
+                setVertexAttribArray(firstAttribute + k, _instanceData[k].get(), osg::Array::BIND_PER_VERTEX);
+                program->addBindAttribLocation("instanceData" + std::to_string(k), firstAttribute + k);
+                stateSet->setAttribute(new osg::VertexAttribDivisor(firstAttribute + k, 1));
+            }
+
+            setDataVariance(osg::Object::DYNAMIC);
+            setUseDisplayList(false);
+            setUseVertexBufferObjects(true);
+        }
+
+        /*-----------------------------------------
+         * GETTERS AND SETTERS
+         *---------------------------------------*/
+
+        bool InstancedPrimitive::isInstanced(const ShapeType type)
+        {
+            return ShapeType::BOX == type || ShapeType::CYLINDER == type || ShapeType::CONE == type
+                    || ShapeType::SPHERE == type;
+        }
+
+        std::size_t InstancedPrimitive::getNumInstances() const
+        {
+            return _numInstances;
+        }
+
+        void InstancedPrimitive::setInstance(const std::size_t instance, const osg::Matrixd& mat,
+                                             const osg::Vec4f& color)
+        {
+            for (int row = 0; row < 4; ++row)
+                (*_instanceData[row])[instance].set(mat(row, 0), mat(row, 1), mat(row, 2), color[row]);
+        }
+
+        void InstancedPrimitive::dirtyInstances()
+        {
+            for (int row = 0; row < 4; ++row)
+                _instanceData[row]->dirty();
+            dirtyBound();
+        }
+
+        osg::BoundingBox InstancedPrimitive::computeBoundingBox() const
+        {
+            const osg::Vec3 center = _unitBound.center();
+            const osg::Vec3 halfSize = (_unitBound._max - _unitBound._min) * 0.5;
+            osg::BoundingBox bound;
+            for (std::size_t i = 0; i < _numInstances; ++i)
+            {
+                osg::Vec3 instanceCenter(0.0, 0.0, 0.0);
+                osg::Vec3 instanceHalfSize(0.0, 0.0, 0.0);
+                for (int row = 0; row < 3; ++row)
+                {
+                    const osg::Vec4& data = (*_instanceData[row])[i];
+                    for (int col = 0; col < 3; ++col)
+                    {
+                        instanceCenter[col] += data[col] * center[row];
+                        instanceHalfSize[col] += std::fabs(data[col]) * halfSize[row];
+                    }
+                }
+                const osg::Vec4& translation = (*_instanceData[3])[i];
+                instanceCenter += osg::Vec3(translation.x(), translation.y(), translation.z());
+                bound.expandBy(instanceCenter - instanceHalfSize);
+                bound.expandBy(instanceCenter + instanceHalfSize);
+            }
+            return bound;
+        }
+
+    }  // namespace Model
+}  // namespace OMVIS
@@ -30,30 +30,42 @@ namespace OMVIS
     namespace Model
     {
 
-        Pipecylinder::Pipecylinder(const float rI, const float rO, const float l)
-                : osg::Geometry()
+        namespace
         {
             const int nEdges = 20;
+        }
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        Pipecylinder::Pipecylinder(const float rI, const float rO, const float l)
+                : osg::Geometry(),
+                  _rI(rI),
+                  _rO(rO),
+                  _l(l),
+                  _vertices(new osg::Vec3Array(4 * nEdges))
+        {
             double phi = 2 * M_PI / nEdges;
 
             //VERTICES
-            osg::ref_ptr<osg::Vec3Array> vertices = new osg::Vec3Array(4*nEdges);
+            osg::Vec3Array& vertices = *_vertices;
 
             for (int i = 0; i < nEdges; ++i)
             {
                 // inner base ring
-                (*vertices)[i] = osg::Vec3(sin(phi * i) * rI, cos(phi * i) * rI, 0);
+                vertices[i] = osg::Vec3(sin(phi * i) * rI, cos(phi * i) * rI, 0);
 
                 // outer base ring
-                (*vertices)[i+nEdges] = osg::Vec3(sin(phi * i) * rO, cos(phi * i) * rO, 0);
+                vertices[i+nEdges] = osg::Vec3(sin(phi * i) * rO, cos(phi * i) * rO, 0);
 
                 // inner end ring
-                (*vertices)[i+2*nEdges] = osg::Vec3(sin(phi * i) * rI, cos(phi * i) * rI, l);
+                vertices[i+2*nEdges] = osg::Vec3(sin(phi * i) * rI, cos(phi * i) * rI, l);
 
                 // outer end ring
-                (*vertices)[i+3*nEdges] = osg::Vec3(sin(phi * i) * rO, cos(phi * i) * rO, l);
+                vertices[i+3*nEdges] = osg::Vec3(sin(phi * i) * rO, cos(phi * i) * rO, l);
             }
-            this->setVertexArray(vertices);
+            this->setVertexArray(_vertices);
 
             //PLANES
             // base plane bottom
@@ -130,5 +142,36 @@ namespace OMVIS
             }
         }
 
+        /*-----------------------------------------
+         * GETTERS AND SETTERS
+         *---------------------------------------*/
+
+        float Pipecylinder::getInnerRadius() const
+        {
+            return _rI;
+        }
+
+        float Pipecylinder::getOuterRadius() const
+        {
+            return _rO;
+        }
+
+        float Pipecylinder::getLength() const
+        {
+            return _l;
+        }
+
+        void Pipecylinder::setLength(const float l)
+        {
+            _l = l;
+            // The end rings are the upper half of the vertex array.
+            for (int i = 2 * nEdges; i < 4 * nEdges; ++i)
+                (*_vertices)[i].z() = l;
+
+            _vertices->dirty();
+            dirtyDisplayList();
+            dirtyBound();
+        }
+
     }  // namespace Model
 }  // namespace OMVIS
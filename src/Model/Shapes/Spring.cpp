@@ -28,36 +28,102 @@ namespace OMVIS
     namespace Model
     {
 
+        namespace
+        {
+            const int ELEMENTS_WINDING = 10;
+            const int ELEMENTS_CONTOUR = 6;
+        }
+
         /*-----------------------------------------
          * CONSTRUCTORS
          *---------------------------------------*/
 
         Spring::Spring(const float r, const float rCoil, const float nWindings, const float l)
                 : osg::Geometry(),
-                  _outerVertices(nullptr),
-                  _splineVertices(nullptr)
+                  _r(r),
+                  _rCoil(rCoil),
+                  _nWindings(nWindings),
+                  _l(l),
+                  _numSegments((ELEMENTS_WINDING * nWindings) + 1),
+                  _outerVertices(new osg::Vec3Array((_numSegments + 1) * ELEMENTS_CONTOUR)),
+                  _splineVertices(new osg::Vec3Array(_numSegments))
         {
-            const int ELEMENTS_WINDING = 10;
-            const int ELEMENTS_CONTOUR = 6;
+            computeVertices();
 
-            //the inner line points
-            int numSegments = (ELEMENTS_WINDING * nWindings) + 1;
-            _splineVertices = new osg::Vec3Array(numSegments);
+            // pass the created vertex array to the points geometry object.
+            this->setVertexArray(_outerVertices);
+
+            //PLANES
+            // base plane bottom
+            osg::DrawElementsUInt* basePlane;  // = new osg::DrawElementsUInt(osg::PrimitiveSet::QUADS, 0);
+            int numFacettes = ELEMENTS_CONTOUR * (_numSegments - 2);
+            for (int i = 0; i < numFacettes; ++i)
+            {
+                basePlane = new osg::DrawElementsUInt(osg::PrimitiveSet::QUADS, 4);
+                (*basePlane)[0] = i;
+                (*basePlane)[1] = i + 1;
+                (*basePlane)[2] = i + ELEMENTS_CONTOUR;
+                (*basePlane)[3] = i + ELEMENTS_CONTOUR - 1;
+
+                this->addPrimitiveSet(basePlane);
+            }
+            //std::cout << "NUM " << outerVertices->size() << std::endl;
+            //this->addPrimitiveSet(new osg::DrawArrays(osg::PrimitiveSet::POINTS, 0, outerVertices->size()));
+        }
+
+        /*-----------------------------------------
+         * GETTERS AND SETTERS
+         *---------------------------------------*/
+
+        float Spring::getRadius() const
+        {
+            return _r;
+        }
+
+        float Spring::getCoilRadius() const
+        {
+            return _rCoil;
+        }
+
+        float Spring::getNumWindings() const
+        {
+            return _nWindings;
+        }
+
+        float Spring::getLength() const
+        {
+            return _l;
+        }
+
+        void Spring::setLength(const float l)
+        {
+            _l = l;
+            computeVertices();
 
+            _outerVertices->dirty();
+            dirtyDisplayList();
+            dirtyBound();
+        }
+
+        /*-----------------------------------------
+         * PRIVATE METHODS
+         *---------------------------------------*/
+
+        void Spring::computeVertices()
+        {
+            //the inner line points
             double c1 = 2.0 * M_PI / static_cast<double>(ELEMENTS_WINDING);
-            double c2 = l / numSegments;
+            double c2 = _l / _numSegments;
             float x, y, z;
-            for (int segIdx = 0; segIdx < numSegments; ++segIdx)
+            for (int segIdx = 0; segIdx < _numSegments; ++segIdx)
             {
-                x = std::sin(c1 * segIdx) * r;
-                y = std::cos(c1 * segIdx) * r;
+                x = std::sin(c1 * segIdx) * _r;
+                y = std::cos(c1 * segIdx) * _r;
                 z = c2 * segIdx;
                 (*_splineVertices)[segIdx].set(osg::Vec3(x, y, z));
             }
 
             //the outer points for the facets
-            int numVertices = (numSegments + 1) * ELEMENTS_CONTOUR;
-            _outerVertices = new osg::Vec3Array(numVertices);
             osg::Vec3f normal;
             osg::Vec3f v1;
             osg::Vec3f v2;
@@ -65,13 +131,13 @@ namespace OMVIS
             osg::Vec3f vec0, a1;
             float angle;
             float c3 = M_PI * 2 / ELEMENTS_CONTOUR;
-            for (int i = 0; i < numSegments - 1; ++i)
+            for (int i = 0; i < _numSegments - 1; ++i)
             {
                 v1 = (*_splineVertices)[i];
                 v2 = (*_splineVertices)[i + 1];
                 normal = osg::Vec3f(v2[0] - v1[0], v2[1] - v1[1], v2[2] - v1[2]);
                 vec0 = normal;
-                normal = getNormal(normal, rCoil);
+                normal = getNormal(normal, _rCoil);
                 for (int i1 = 0; i1 < ELEMENTS_CONTOUR; ++i1)
                 {
                     angle = c3 * i1;
@@ -80,26 +146,6 @@ namespace OMVIS
                     ++vertIdx;
                 }
             }
-
-            // pass the created vertex array to the points geometry object.
-            this->setVertexArray(_outerVertices);
-
-            //PLANES
-            // base plane bottom
-            osg::DrawElementsUInt* basePlane;  // = new osg::DrawElementsUInt(osg::PrimitiveSet::QUADS, 0);
-            int numFacettes = ELEMENTS_CONTOUR * (numSegments - 2);
-            for (int i = 0; i < numFacettes; ++i)
-            {
-                basePlane = new osg::DrawElementsUInt(osg::PrimitiveSet::QUADS, 4);
-                (*basePlane)[0] = i;
-                (*basePlane)[1] = i + 1;
-                (*basePlane)[2] = i + ELEMENTS_CONTOUR;
-                (*basePlane)[3] = i + ELEMENTS_CONTOUR - 1;
-
-                this->addPrimitiveSet(basePlane);
-            }
-            //std::cout << "NUM " << outerVertices->size() << std::endl;
-            //this->addPrimitiveSet(new osg::DrawArrays(osg::PrimitiveSet::POINTS, 0, outerVertices->size()));
         }
 
         /*-----------------------------------------
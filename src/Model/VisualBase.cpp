@@ -39,6 +39,7 @@ namespace OMVIS
                   _path(path),
                   _xmlDoc(),
                   _shapes(),
+                  _shapeTable(),
                   _xmlFileName(Util::getXMLFileName(modelFile, path))
         {
         }
@@ -82,6 +83,10 @@ namespace OMVIS
             rapidxml::xml_node<>* expNode;
             Model::ShapeObject shape;
 
+            // In case of reloading, the shapes of the former file have to be removed.
+            _shapeTable.clear();
+            _shapes.clear();
+
             //Begin std::vector<T>::reserve()
             //int i = 0;
             //for (rapidxml::xml_node<>* shapeNode = rootNode->first_node("shape"); shapeNode; shapeNode = shapeNode->next_sibling())
@@ -125,6 +130,12 @@ namespace OMVIS
                             throw std::runtime_error(msg);
                         }
                     }
+                    shape._shapeType = getShapeTypeForString(shape._type);
+                    if (ShapeType::UNKNOWN == shape._shapeType || ShapeType::CAD == shape._shapeType)
+                    {
+                        LOGGER_WRITE("Unknown type " + shape._type + " of shape " + shape._id + ", we make a capsule.",
+                                     Util::LC_LOADER, Util::LL_WARNING);
+                    }
                     //std::cout<<"type "<<shape._id<<std::endl;
                     //std::cout<<"type "<<shape._type<<std::endl;
 
@@ -198,6 +209,12 @@ namespace OMVIS
                 }
             }  // end for-loop
 
+            _shapeTable.build(_shapes);
+            LOGGER_WRITE("Found " + std::to_string(_shapeTable.getNumDynamic()) + " non-constant attributes of "
+                         + std::to_string(_shapes.size()) + " shapes referencing "
+                         + std::to_string(_shapeTable.getNumVariables()) + " distinct variables.", Util::LC_LOADER,
+                         Util::LL_DEBUG);
+
             //std::vector<std::string> vs = getVisualizationVariables();
         }
 
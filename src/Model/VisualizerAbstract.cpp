@@ -19,6 +19,8 @@
 
 #include "Model/VisualizerAbstract.hpp"
 #include "Util/Logger.hpp"
+#include "Util/StageStatistics.hpp"
+#include "Util/Tracer.hpp"
 
 #include <boost/filesystem.hpp>
 
@@ -30,6 +32,8 @@ namespace OMVIS
     namespace Model
     {
 
+        constexpr std::size_t VisualizerAbstract::shapeGrainSize;
+
         /*-----------------------------------------
          * CONSTRUCTORS
          *---------------------------------------*/
@@ -39,7 +43,12 @@ namespace OMVIS
                   _baseData(nullptr),
                   _viewerStuff(nullptr),
                   _nodeUpdater(nullptr),
-                  _timeManager(nullptr)
+                  _shapeNodes(),
+                  _timeManager(nullptr),
+                  _threadPool(),
+                  _numUpdatedShapes(0),
+                  _numSkippedShapes(0),
+                  _frameTimes()
         {
         }
 
@@ -48,8 +57,13 @@ namespace OMVIS
                 : _visType(visType),
                   _baseData(nullptr),
                   _viewerStuff(std::make_shared<OMVISScene>()),
-                  _nodeUpdater(std::make_shared<Model::UpdateVisitor>()),
-                  _timeManager(std::make_shared<Control::TimeManager>(0.0, 0.0, 0.0, 0.0, 0.1, 0.0, 100.0))
+                  _nodeUpdater(std::make_shared<Model::NodeUpdater>()),
+                  _shapeNodes(),
+                  _timeManager(std::make_shared<Control::TimeManager>(0.0, 0.0, 0.0, 0.0, 0.1, 0.0, 100.0)),
+                  _threadPool(),
+                  _numUpdatedShapes(0),
+                  _numSkippedShapes(0),
+                  _frameTimes()
         {
             // We need the absolute path to the directory. Otherwise the FMUlibrary can not open the shared objects.
             //char fullPathTmp[PATH_MAX];
@@ -89,7 +103,10 @@ namespace OMVIS
             // Build scene graph.
             LOGGER_WRITE("Setup scene for " + std::to_string(_baseData->_shapes.size()) + " shapes.", Util::LC_LOADER,
                          Util::LL_DEBUG);
-            _viewerStuff->getScene()->setUpScene(_baseData->_shapes);
+            // The constant shapes are baked with their current matrices.
+            computeTransforms();
+            _shapeNodes = _viewerStuff->getScene()->setUpScene(_baseData->_shapes,
+                                                               _baseData->_shapeTable.getConstShapes());
         }
 
         /*-----------------------------------------
@@ -121,13 +138,31 @@ namespace OMVIS
             return _baseData->getModelFile();
         }
 
+        std::size_t VisualizerAbstract::getNumUpdatedShapes() const
+        {
+            return _numUpdatedShapes;
+        }
+
+        std::size_t VisualizerAbstract::getNumSkippedShapes() const
+        {
+            return _numSkippedShapes;
+        }
+
+        const Util::FrameTimes& VisualizerAbstract::getFrameTimes() const
+        {
+            return _frameTimes;
+        }
+
         /*-----------------------------------------
          * SIMULATION METHODS
          *---------------------------------------*/
 
         void VisualizerAbstract::startVisualization()
         {
-            if (_timeManager->getVisTime() < _timeManager->getEndTime() - 1.e-6)
+            // A negative visualization step size plays the result backwards.
+            const bool reverse = (0.0 > _timeManager->getHVisual());
+            if ((!reverse && _timeManager->getVisTime() < _timeManager->getEndTime() - 1.e-6)
+                    || (reverse && _timeManager->getVisTime() > _timeManager->getStartTime() + 1.e-6))
             {
                 _timeManager->setPause(false);
                 LOGGER_WRITE("Start visualization ...", Util::LC_CTR, Util::LL_INFO);
@@ -157,19 +192,24 @@ namespace OMVIS
 
         void VisualizerAbstract::sceneUpdate()
         {
+            Util::TraceScope trace("sceneUpdate", "frame");
             _timeManager->updateTick();
 
             if (!_timeManager->isPaused())
             {
+                _frameTimes.fill(0.0);
                 updateScene(_timeManager->getVisTime());
+                Util::StageStatistics::getInstance().record(_frameTimes);
                 _timeManager->setVisTime(_timeManager->getVisTime() + _timeManager->getHVisual());
 
                 LOGGER_WRITE(
                         "Update scene at " + std::to_string(_timeManager->getVisTime()) + " simTime "
                                 + std::to_string(_timeManager->getSimTime()) + " _visStepSize "
                                 + std::to_string(_timeManager->getHVisual()),
-                        Util::LC_CTR, Util::LL_INFO);
-                if (_timeManager->getVisTime() >= _timeManager->getEndTime() - 1.e-6)
+                        Util::LC_CTR, Util::LL_DEBUG);
+                const bool reverse = (0.0 > _timeManager->getHVisual());
+                if ((!reverse && _timeManager->getVisTime() >= _timeManager->getEndTime() - 1.e-6)
+                        || (reverse && _timeManager->getVisTime() <= _timeManager->getStartTime() + 1.e-6))
                 {
                     LOGGER_WRITE("The End.", Util::LC_CTR, Util::LL_INFO);
                     _timeManager->setPause(true);
@@ -177,5 +217,42 @@ namespace OMVIS
             }
         }
 
+        void VisualizerAbstract::computeTransforms()
+        {
+            Util::StageTimer timer(_frameTimes, Util::FS_TRANSFORM);
+            // The thread pool only passes a pointer to the lambda to its workers, thus the frame does not allocate.
+            _threadPool.parallelFor(_baseData->_shapes.size(), shapeGrainSize,
+                                    [this](std::size_t begin, std::size_t end)
+            {
+                auto& shapes = _baseData->_shapes;
+                ShapeTable& table = _baseData->_shapeTable;
+                double* matrices = table.getMatrices();
+                Util::transformBatch(table.getTransformInputs(), begin, end, matrices);
+                for (std::size_t i = begin; i < end; ++i)
+                    shapes[i]._mat.set(matrices + 16 * i);
+            });
+        }
+
+        void VisualizerAbstract::updateSceneNodes()
+        {
+            Util::StageTimer timer(_frameTimes, Util::FS_APPLY);
+            auto& shapes = _baseData->_shapes;
+            ShapeTable& table = _baseData->_shapeTable;
+            _numUpdatedShapes = 0;
+
+            // The constant shapes are part of the static scene.
+            for (const std::uint32_t shapeIdx : table.getDynamicShapes())
+            {
+                if (table.isDirty(shapeIdx))
+                {
+                    _nodeUpdater->update(_shapeNodes[shapeIdx], shapes[shapeIdx]);
+                    ++_numUpdatedShapes;
+                }
+            }
+            _nodeUpdater->finishFrame();
+            table.clearDirty();
+            _numSkippedShapes = shapes.size() - _numUpdatedShapes;
+        }
+
     }  // namespace Model
 }  // namespace OMVIS
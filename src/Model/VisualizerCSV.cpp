@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/VisualizerCSV.hpp"
+#include "Util/Logger.hpp"
+#include "Util/Util.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        namespace
+        {
+            //! Marks an empty entry of \ref VisualizerCSV::_loadedRows.
+            const std::size_t noRow = std::numeric_limits<std::size_t>::max();
+        }
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        VisualizerCSV::VisualizerCSV(const std::string& modelFile, const std::string& path)
+                : VisualizerAbstract(modelFile, path, VisType::CSV),
+                  _csvFile(),
+                  _slots(),
+                  _columns(),
+                  _rows(),
+                  _loadedRows { { noRow, noRow } }
+        {
+        }
+
+        /*-----------------------------------------
+         * INITIALIZATION METHODS
+         *---------------------------------------*/
+
+        void VisualizerCSV::initData()
+        {
+            VisualizerAbstract::initData();
+            readCsv(_baseData->getModelFile(), _baseData->getPath());
+            bindVisAttributes();
+            _timeManager->setStartTime(_csvFile.getStartTime());
+            _timeManager->setEndTime(_csvFile.getStopTime());
+        }
+
+        void VisualizerCSV::initializeVisAttributes(const double time)
+        {
+            if (0.0 > time)
+            {
+                LOGGER_WRITE("Cannot load visualization attributes for time point < 0.0.", Util::LC_LOADER,
+                             Util::LL_ERROR);
+            }
+            updateVisAttributes(time);
+        }
+
+        void VisualizerCSV::readCsv(const std::string& modelFile, const std::string& path)
+        {
+            std::string resFileName = path + modelFile;
+
+            // Check if the CSV file exists.
+            if (!Util::fileExists(resFileName))
+            {
+                auto msg = "Could not find CSV file" + resFileName + ".";
+                LOGGER_WRITE(msg, Util::LC_LOADER, Util::LL_ERROR);
+                throw std::runtime_error(msg);
+            }
+
+            // Map csv file. Throws if the file has no header or no data.
+            _csvFile.open(resFileName);
+        }
+
+        void VisualizerCSV::bindVisAttributes()
+        {
+            ShapeTable& table = _baseData->_shapeTable;
+            std::vector<std::size_t> unresolved;
+            std::vector<std::size_t> attrColumns;
+            for (std::size_t i = 0; i < table.getNumVariables(); ++i)
+            {
+                std::size_t column;
+                if (!_csvFile.findVariable(table.getVariable(i), column))
+                {
+                    LOGGER_WRITE("Did not get variable from result file. Variable name is " + table.getVariable(i)
+                                 + ".", Util::LC_LOADER, Util::LL_ERROR);
+                    unresolved.push_back(i);
+                }
+                else
+                {
+                    attrColumns.push_back(column);
+                }
+            }
+            table.makeConst(unresolved, 0.0);
+
+            // A row is tokenized front to back once, so the columns are read in ascending order.
+            _columns = attrColumns;
+            std::sort(_columns.begin(), _columns.end());
+            _columns.erase(std::unique(_columns.begin(), _columns.end()), _columns.end());
+            _slots.resize(attrColumns.size());
+            for (std::size_t i = 0; i < attrColumns.size(); ++i)
+                _slots[i] = std::lower_bound(_columns.begin(), _columns.end(), attrColumns[i]) - _columns.begin();
+
+            for (auto& values : _rows)
+                values.resize(_columns.size());
+            _loadedRows = { { noRow, noRow } };
+            LOGGER_WRITE("Bound " + std::to_string(_slots.size()) + " variables to " + std::to_string(_columns.size())
+                         + " CSV file columns.", Util::LC_LOADER, Util::LL_DEBUG);
+        }
+
+        void VisualizerCSV::loadRow(const std::size_t idx, const std::size_t row)
+        {
+            if (row == _loadedRows[idx])
+                return;
+
+            // During playback, the row has typically been the other bracketing row of the last frame.
+            if (row == _loadedRows[1 - idx])
+            {
+                std::swap(_rows[0], _rows[1]);
+                std::swap(_loadedRows[0], _loadedRows[1]);
+                return;
+            }
+
+            _csvFile.readRow(row, _columns, _rows[idx].data());
+            _loadedRows[idx] = row;
+        }
+
+        /*-----------------------------------------
+         * SIMULATION METHODS
+         *---------------------------------------*/
+
+        void VisualizerCSV::updateVisAttributes(const double time)
+        {
+            try
+            {
+                // Get the values for the scene graph objects. Constant attributes are not bound.
+                Util::StageTimer fetchTimer(_frameTimes, Util::FS_FETCH);
+                ShapeTable& table = _baseData->_shapeTable;
+                float* values = table.getVariableValues();
+                _csvFile.seek(time);
+                const std::size_t row = _csvFile.getCursorRow();
+                const double weight = _csvFile.getCursorWeight();
+                loadRow(0, row);
+                if (0.0 == weight)
+                {
+                    for (std::size_t i = 0; i < _slots.size(); ++i)
+                        values[i] = _rows[0][_slots[i]];
+                }
+                else
+                {
+                    loadRow(1, row + 1);
+                    for (std::size_t i = 0; i < _slots.size(); ++i)
+                    {
+                        const double lo = _rows[0][_slots[i]];
+                        values[i] = lo + weight * (_rows[1][_slots[i]] - lo);
+                    }
+                }
+                table.scatter();
+                fetchTimer.stop();
+
+                computeTransforms();
+
+                // Update the shapes.
+                updateSceneNodes();
+            }
+            catch (std::exception& ex)
+            {
+                auto msg = "Error in VisualizerCSV::updateVisAttributes at time point " + std::to_string(time) + "\n"
+                        + std::string(ex.what());
+                LOGGER_WRITE(msg, Util::LC_SOLVER, Util::LL_WARNING);
+                throw(msg);
+            }
+        }
+
+        void VisualizerCSV::updateScene(const double time)
+        {
+            if (0.0 > time)
+            {
+                LOGGER_WRITE("Cannot load visualization attributes for time point < 0.0.", Util::LC_SOLVER,
+                             Util::LL_ERROR);
+            }
+
+            _timeManager->updateTick();  //for real-time measurement
+            double visTime = _timeManager->getRealTime();
+
+            updateVisAttributes(time);
+
+            _timeManager->updateTick();  //for real-time measurement
+            visTime = _timeManager->getRealTime() - visTime;
+            _timeManager->setRealTimeFactor(_timeManager->getHVisual() / visTime);
+        }
+
+        void VisualizerCSV::setSimulationSettings(const Model::UserSimSettingsMAT& simSetCSV)
+        {
+            auto newVal = simSetCSV.speedup * _timeManager->getHVisual();
+            _timeManager->setHVisual(newVal);
+        }
+
+    }  // namespace Model
+}  // namespace OMVIS
@@ -19,6 +19,7 @@
 
 #include "Model/VisualizerFMU.hpp"
 #include "Util/Logger.hpp"
+#include "Util/Tracer.hpp"
 #include "Util/Util.hpp"
 
 #include <SDL.h>
@@ -39,6 +40,8 @@ namespace OMVIS
                   _fmu(std::make_shared<FMUWrapper>()),
                   _simSettings(std::make_shared<SimSettingsFMU>()),
                   _inputData(std::make_shared<InputData>()),
+                  _valueRefs(),
+                  _fmuValues(),
                   _joysticks()
         {
             LOGGER_WRITE("Initialize joysticks", Util::LC_LOADER, Util::LL_INFO);
@@ -140,62 +143,32 @@ namespace OMVIS
             return _inputData;
         }
 
-        fmi1_value_reference_t VisualizerFMU::getVarReferencesForObjectAttribute(ShapeObjectAttribute* attr)
-        {
-            fmi1_value_reference_t vr = 0;
-            if (!attr->isConst)
-            {
-                fmi1_import_variable_t* var = fmi1_import_get_variable_by_name(_fmu->getFMU(), attr->cref.c_str());
-                vr = fmi1_import_get_variable_vr(var);
-            }
-            return vr;
-        }
-
         int VisualizerFMU::setVarReferencesInVisAttributes()
         {
             int isOk(0);
 
             try
             {
-                size_t i = 0;
-                for (auto& shape : _baseData->_shapes)
+                ShapeTable& table = _baseData->_shapeTable;
+                std::vector<std::size_t> unresolved;
+                _valueRefs.clear();
+                for (std::size_t i = 0; i < table.getNumVariables(); ++i)
                 {
-                    shape = _baseData->_shapes[i];
-
-                    shape._length.fmuValueRef = getVarReferencesForObjectAttribute(&shape._length);
-                    shape._width.fmuValueRef = getVarReferencesForObjectAttribute(&shape._width);
-                    shape._height.fmuValueRef = getVarReferencesForObjectAttribute(&shape._height);
-
-                    shape._lDir[0].fmuValueRef = getVarReferencesForObjectAttribute(&shape._lDir[0]);
-                    shape._lDir[1].fmuValueRef = getVarReferencesForObjectAttribute(&shape._lDir[1]);
-                    shape._lDir[2].fmuValueRef = getVarReferencesForObjectAttribute(&shape._lDir[2]);
-
-                    shape._wDir[0].fmuValueRef = getVarReferencesForObjectAttribute(&shape._wDir[0]);
-                    shape._wDir[1].fmuValueRef = getVarReferencesForObjectAttribute(&shape._wDir[1]);
-                    shape._wDir[2].fmuValueRef = getVarReferencesForObjectAttribute(&shape._wDir[2]);
-
-                    shape._r[0].fmuValueRef = getVarReferencesForObjectAttribute(&shape._r[0]);
-                    shape._r[1].fmuValueRef = getVarReferencesForObjectAttribute(&shape._r[1]);
-                    shape._r[2].fmuValueRef = getVarReferencesForObjectAttribute(&shape._r[2]);
-
-                    shape._rShape[0].fmuValueRef = getVarReferencesForObjectAttribute(&shape._rShape[0]);
-                    shape._rShape[1].fmuValueRef = getVarReferencesForObjectAttribute(&shape._rShape[1]);
-                    shape._rShape[2].fmuValueRef = getVarReferencesForObjectAttribute(&shape._rShape[2]);
-
-                    shape._T[0].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[0]);
-                    shape._T[1].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[1]);
-                    shape._T[2].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[2]);
-                    shape._T[3].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[3]);
-                    shape._T[4].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[4]);
-                    shape._T[5].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[5]);
-                    shape._T[6].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[6]);
-                    shape._T[7].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[7]);
-                    shape._T[8].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[8]);
-
-                    //shape.dumpVisAttributes();
-                    _baseData->_shapes.at(i) = shape;
-                    ++i;
-                }  //end for
+                    fmi1_import_variable_t* var = fmi1_import_get_variable_by_name(_fmu->getFMU(),
+                                                                                   table.getVariable(i).c_str());
+                    if (nullptr == var)
+                    {
+                        LOGGER_WRITE("Did not get variable from FMU. Variable name is " + table.getVariable(i) + ".",
+                                     Util::LC_LOADER, Util::LL_ERROR);
+                        unresolved.push_back(i);
+                    }
+                    else
+                    {
+                        _valueRefs.push_back(fmi1_import_get_variable_vr(var));
+                    }
+                }
+                table.makeConst(unresolved, 0.0);
+                _fmuValues.resize(_valueRefs.size());
             }  // end try
 
             catch (std::exception& e)
@@ -259,6 +232,7 @@ namespace OMVIS
 
         double VisualizerFMU::simulateStep(const double time)
         {
+            Util::TraceScope trace("simulateStep", "simulation");
             _fmu->prepareSimulationStep(time);
 
             /* Check if an event indicator has triggered */
@@ -277,10 +251,12 @@ namespace OMVIS
             _fmu->updateTimes(_simSettings->getTend());
 
             // Set inputs.
+            Util::StageTimer inputTimer(_frameTimes, Util::FS_INPUT);
             for (auto& joystick : _joysticks)
             {
                 joystick->detectContinuousInputEvents(_inputData);
             }
+            inputTimer.stop();
             _inputData->setInputsInFMU(_fmu->getFMU());
             //_inputData->printValues();
 
@@ -320,66 +296,26 @@ namespace OMVIS
 
         void VisualizerFMU::updateVisAttributes(const double time)
         {
-            // Update all shapes.
-            OMVIS::Util::rAndT rT;
-            osg::ref_ptr<osg::Node> child = nullptr;
             try
             {
-                fmi1_import_t* fmu = _fmu->getFMU();
-                size_t i = 0;
-                for (auto& shape : _baseData->_shapes)
+                // All values are fetched with one call, the FMU must not be accessed concurrently anyway.
+                Util::StageTimer fetchTimer(_frameTimes, Util::FS_FETCH);
+                ShapeTable& table = _baseData->_shapeTable;
+                if (!_valueRefs.empty())
                 {
-                    // Get the values for the scene graph objects
-                    updateObjectAttributeFMU(&shape._length, fmu);
-                    updateObjectAttributeFMU(&shape._width, fmu);
-                    updateObjectAttributeFMU(&shape._height, fmu);
-
-                    updateObjectAttributeFMU(&shape._lDir[0], fmu);
-                    updateObjectAttributeFMU(&shape._lDir[1], fmu);
-                    updateObjectAttributeFMU(&shape._lDir[2], fmu);
-
-                    updateObjectAttributeFMU(&shape._wDir[0], fmu);
-                    updateObjectAttributeFMU(&shape._wDir[1], fmu);
-                    updateObjectAttributeFMU(&shape._wDir[2], fmu);
-
-                    updateObjectAttributeFMU(&shape._r[0], fmu);
-                    updateObjectAttributeFMU(&shape._r[1], fmu);
-                    updateObjectAttributeFMU(&shape._r[2], fmu);
-
-                    updateObjectAttributeFMU(&shape._rShape[0], fmu);
-                    updateObjectAttributeFMU(&shape._rShape[1], fmu);
-                    updateObjectAttributeFMU(&shape._rShape[2], fmu);
-
-                    updateObjectAttributeFMU(&shape._T[0], fmu);
-                    updateObjectAttributeFMU(&shape._T[1], fmu);
-                    updateObjectAttributeFMU(&shape._T[2], fmu);
-                    updateObjectAttributeFMU(&shape._T[3], fmu);
-                    updateObjectAttributeFMU(&shape._T[4], fmu);
-                    updateObjectAttributeFMU(&shape._T[5], fmu);
-                    updateObjectAttributeFMU(&shape._T[6], fmu);
-                    updateObjectAttributeFMU(&shape._T[7], fmu);
-                    updateObjectAttributeFMU(&shape._T[8], fmu);
-                    rT = Util::rotation(
-                            osg::Vec3f(shape._r[0].exp, shape._r[1].exp, shape._r[2].exp),
-                            osg::Vec3f(shape._rShape[0].exp, shape._rShape[1].exp, shape._rShape[2].exp),
-                            osg::Matrix3(shape._T[0].exp, shape._T[1].exp, shape._T[2].exp, shape._T[3].exp,
-                                         shape._T[4].exp, shape._T[5].exp, shape._T[6].exp, shape._T[7].exp,
-                                         shape._T[8].exp),
-                            osg::Vec3f(shape._lDir[0].exp, shape._lDir[1].exp, shape._lDir[2].exp),
-                            osg::Vec3f(shape._wDir[0].exp, shape._wDir[1].exp, shape._wDir[2].exp), shape._length.exp,
-                            shape._type);
-
-                    Util::assemblePokeMatrix(shape._mat, rT._T, rT._r);
-
-                    // Update the shapes.
-                    _nodeUpdater->_shape = shape;
-
-                    // Get the scene graph nodes and stuff.
-                    //_viewerStuff->dumpOSGTreeDebug();
-                    child = _viewerStuff->getScene()->getRootNode()->getChild(i);  // the transformation
-                    child->accept(*_nodeUpdater);
-                    ++i;
-                }  //end for
+                    Util::TraceScope trace("fmi1_import_get_real", "fmi");
+                    fmi1_import_get_real(_fmu->getFMU(), _valueRefs.data(), _valueRefs.size(), _fmuValues.data());
+                }
+                float* values = table.getVariableValues();
+                for (std::size_t i = 0; i < _fmuValues.size(); ++i)
+                    values[i] = static_cast<float>(_fmuValues[i]);
+                table.scatter();
+                fetchTimer.stop();
+
+                computeTransforms();
+
+                // Update the shapes.
+                updateSceneNodes();
             }  // end try
             catch (std::exception& ex)
             {
@@ -398,27 +334,18 @@ namespace OMVIS
             double nextStep = _timeManager->getVisTime() + _timeManager->getHVisual();
 
             double vis1 = _timeManager->getRealTime();
+            Util::StageTimer simulateTimer(_frameTimes, Util::FS_SIMULATE);
             while (_timeManager->getSimTime() < nextStep)
             {
                 //std::cout<<"simulate "<<omvManager->_simTime<<" to "<<nextStep<<std::endl;
                 //_inputData.printValues();
                 _timeManager->setSimTime(simulateStep(_timeManager->getSimTime()));
             }
+            simulateTimer.stop();
             _timeManager->updateTick();                     //for real-time measurement
             _timeManager->setRealTimeFactor(_timeManager->getHVisual() / (_timeManager->getRealTime() - vis1));
             updateVisAttributes(_timeManager->getVisTime());
         }
 
-        // Todo pass by const ref
-        void VisualizerFMU::updateObjectAttributeFMU(Model::ShapeObjectAttribute* attr, fmi1_import_t* fmu)
-        {
-            if (!attr->isConst)
-            {
-                fmi1_real_t a = attr->exp;
-                fmi1_import_get_real(fmu, &attr->fmuValueRef, 1, &a);
-                attr->exp = static_cast<float>(a);
-            }
-        }
-
     }  // namespace Model
 }  // namespace OMVIS
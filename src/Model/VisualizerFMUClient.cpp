@@ -19,6 +19,7 @@
 
 #include "Model/VisualizerFMUClient.hpp"
 #include "Util/Logger.hpp"
+#include "Util/Tracer.hpp"
 
 namespace OMVIS
 {
@@ -35,6 +36,7 @@ namespace OMVIS
                   _simID(-1),
                   _simSettings(std::make_shared<SimSettingsFMU>()),
                   _outputVars(),
+                  _outputIndices(),
                   _inputData(std::make_shared<InputData>()),
                   _joysticks(),
                   _remotePathToModelFile(cP->path)
@@ -232,10 +234,12 @@ namespace OMVIS
 
         double VisualizerFMUClient::simulateStep(const double time)
         {
+            Util::TraceScope trace("simulateStep", "simulation");
             double newTime = time + _simSettings->getHdef();
 
             NetOff::ValueContainer& inputCont = _noFC.getInputValueContainer(_simID);
             // Set inputs in inputData
+            Util::StageTimer inputTimer(_frameTimes, Util::FS_INPUT);
             for (auto& joystick : _joysticks)
             {
                 joystick->detectContinuousInputEvents(_inputData);
@@ -243,6 +247,7 @@ namespace OMVIS
                 //_inputData->setInputsInFMU(_fmu->getFMU()); //todo aus der schleife raus???
                 //std::cout << "JOY" << i << " XDir " <<_joysticks[i]->getXDir() <<" YDir "<< _joysticks[i]->getYDir() << std::endl;
             }
+            inputTimer.stop();
 
             // Set inputs for network communication.
             inputCont.setRealValues(_inputData->getRealValues());
@@ -250,9 +255,15 @@ namespace OMVIS
             inputCont.setBoolValues(_inputData->getBoolValues());
 
             // Send input values to server
-            _noFC.sendInputValues(_simID, newTime, inputCont);
+            {
+                Util::TraceScope trace("sendInputValues", "network");
+                _noFC.sendInputValues(_simID, newTime, inputCont);
+            }
             // Receive output values from server for visualisation
-            _noFC.recvOutputValues(_simID, newTime);  // implicit check if its really [time]
+            {
+                Util::TraceScope trace("recvOutputValues", "network");
+                _noFC.recvOutputValues(_simID, newTime);  // implicit check if its really [time]
+            }
             return newTime;
         }
 
@@ -264,54 +275,17 @@ namespace OMVIS
             updateVisAttributes(_timeManager->getVisTime());
         }
 
-        fmi1_value_reference_t VisualizerFMUClient::getVarReferencesForObjectAttribute(ShapeObjectAttribute* attr)
-        {
-            fmi1_value_reference_t vr = 0;
-            if (!attr->isConst)
-            {
-                vr = _outputVars.findRealVariableNameIndex(attr->cref);
-            }
-            return vr;
-        }
-
         int VisualizerFMUClient::setVarReferencesInVisAttributes()
         {
             int isOk(0);
 
             try
             {
-                for (auto& shape : _baseData->_shapes)
-                {
-                    shape._length.fmuValueRef = getVarReferencesForObjectAttribute(&shape._length);
-                    shape._width.fmuValueRef = getVarReferencesForObjectAttribute(&shape._width);
-                    shape._height.fmuValueRef = getVarReferencesForObjectAttribute(&shape._height);
-
-                    shape._lDir[0].fmuValueRef = getVarReferencesForObjectAttribute(&shape._lDir[0]);
-                    shape._lDir[1].fmuValueRef = getVarReferencesForObjectAttribute(&shape._lDir[1]);
-                    shape._lDir[2].fmuValueRef = getVarReferencesForObjectAttribute(&shape._lDir[2]);
-
-                    shape._wDir[0].fmuValueRef = getVarReferencesForObjectAttribute(&shape._wDir[0]);
-                    shape._wDir[1].fmuValueRef = getVarReferencesForObjectAttribute(&shape._wDir[1]);
-                    shape._wDir[2].fmuValueRef = getVarReferencesForObjectAttribute(&shape._wDir[2]);
-
-                    shape._r[0].fmuValueRef = getVarReferencesForObjectAttribute(&shape._r[0]);
-                    shape._r[1].fmuValueRef = getVarReferencesForObjectAttribute(&shape._r[1]);
-                    shape._r[2].fmuValueRef = getVarReferencesForObjectAttribute(&shape._r[2]);
-
-                    shape._rShape[0].fmuValueRef = getVarReferencesForObjectAttribute(&shape._rShape[0]);
-                    shape._rShape[1].fmuValueRef = getVarReferencesForObjectAttribute(&shape._rShape[1]);
-                    shape._rShape[2].fmuValueRef = getVarReferencesForObjectAttribute(&shape._rShape[2]);
-
-                    shape._T[0].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[0]);
-                    shape._T[1].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[1]);
-                    shape._T[2].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[2]);
-                    shape._T[3].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[3]);
-                    shape._T[4].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[4]);
-                    shape._T[5].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[5]);
-                    shape._T[6].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[6]);
-                    shape._T[7].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[7]);
-                    shape._T[8].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[8]);
-                }  //end for
+                // All visualization variables are requested as outputs in getOutputVariables.
+                const ShapeTable& table = _baseData->_shapeTable;
+                _outputIndices.resize(table.getNumVariables());
+                for (std::size_t i = 0; i < table.getNumVariables(); ++i)
+                    _outputIndices[i] = _outputVars.findRealVariableNameIndex(table.getVariable(i));
             }  // end try
 
             catch (std::exception& e)
@@ -326,65 +300,23 @@ namespace OMVIS
         void VisualizerFMUClient::updateVisAttributes(const double time)
         {
             // Update all shapes.
-            OMVIS::Util::rAndT rT;
-            NetOff::ValueContainer & outputCont = _noFC.getOutputValueContainer(_simID);
-            osg::ref_ptr<osg::Node> child = nullptr;
+            const NetOff::ValueContainer& outputCont = _noFC.getOutputValueContainer(_simID);
             try
             {
-                size_t i = 0;
-                for (auto& shape : _baseData->_shapes)
-                {
-                    // get the values for the scene graph objects
-                    Util::updateObjectAttributeFMUClient(shape._length, outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._width, outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._height, outputCont);
-
-                    Util::updateObjectAttributeFMUClient(shape._lDir[0], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._lDir[1], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._lDir[2], outputCont);
-
-                    Util::updateObjectAttributeFMUClient(shape._wDir[0], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._wDir[1], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._wDir[2], outputCont);
-
-                    Util::updateObjectAttributeFMUClient(shape._r[0], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._r[1], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._r[2], outputCont);
-
-                    Util::updateObjectAttributeFMUClient(shape._rShape[0], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._rShape[1], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._rShape[2], outputCont);
-
-                    Util::updateObjectAttributeFMUClient(shape._T[0], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._T[1], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._T[2], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._T[3], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._T[4], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._T[5], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._T[6], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._T[7], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._T[8], outputCont);
-                    rT = Util::rotation(
-                            osg::Vec3f(shape._r[0].exp, shape._r[1].exp, shape._r[2].exp),
-                            osg::Vec3f(shape._rShape[0].exp, shape._rShape[1].exp, shape._rShape[2].exp),
-                            osg::Matrix3(shape._T[0].exp, shape._T[1].exp, shape._T[2].exp, shape._T[3].exp,
-                                         shape._T[4].exp, shape._T[5].exp, shape._T[6].exp, shape._T[7].exp,
-                                         shape._T[8].exp),
-                            osg::Vec3f(shape._lDir[0].exp, shape._lDir[1].exp, shape._lDir[2].exp),
-                            osg::Vec3f(shape._wDir[0].exp, shape._wDir[1].exp, shape._wDir[2].exp), shape._length.exp,
-                            shape._type);
-
-                    Util::assemblePokeMatrix(shape._mat, rT._T, rT._r);
-
-                    // Update the shapes.
-                    _nodeUpdater->_shape = shape;
-
-                    // Get the scene graph nodes and stuff.
-                    //_viewerStuff->dumpOSGTreeDebug();
-                    child = _viewerStuff->getScene()->getRootNode()->getChild(i);  // the transformation
-                    child->accept(*_nodeUpdater);
-                    ++i;
-                }  //end for
+                // Get the values for the scene graph objects.
+                Util::StageTimer fetchTimer(_frameTimes, Util::FS_FETCH);
+                ShapeTable& table = _baseData->_shapeTable;
+                const auto& realValues = outputCont.getRealValues();
+                float* values = table.getVariableValues();
+                for (std::size_t i = 0; i < _outputIndices.size(); ++i)
+                    values[i] = static_cast<float>(realValues[_outputIndices[i]]);
+                table.scatter();
+                fetchTimer.stop();
+
+                computeTransforms();
+
+                // Update the shapes.
+                updateSceneNodes();
             }  // end try
 
             catch (std::exception& ex)
@@ -422,12 +354,14 @@ namespace OMVIS
             double nextStep = _timeManager->getVisTime() + _timeManager->getHVisual();
 
             double vis1 = _timeManager->getRealTime();
+            Util::StageTimer simulateTimer(_frameTimes, Util::FS_SIMULATE);
             while (_timeManager->getSimTime() < nextStep)
             {
                 //std::cout<<"simulate "<<omvManager->_simTime<<" to "<<nextStep<<std::endl;
                 //_inputData.printValues();
                 _timeManager->setSimTime(simulateStep(_timeManager->getSimTime()));
             }
+            simulateTimer.stop();
             _timeManager->updateTick();                     //for real-time measurement
             _timeManager->setRealTimeFactor(_timeManager->getHVisual() / (_timeManager->getRealTime() - vis1));
             updateVisAttributes(_timeManager->getVisTime());
@@ -21,33 +21,23 @@
 #include "Util/Logger.hpp"
 #include "Util/Util.hpp"
 
+#include <fstream>
+
 namespace OMVIS
 {
     namespace Model
     {
 
-        // [MF: 2016-06-13]: This method is not used. Do we need it?
-        //        double* omc_get_varValue1(ModelicaMatReader* reader, const char* varName, double time)
-        //        {
-        //            double val = 0.0;
-        //            double* res = &val;
-        //            ModelicaMatVariable_t* var = nullptr;
-        //            var = omc_matlab4_find_var(reader, varName);
-        //            if (var == nullptr)
-        //                LOGGER_WRITE(std::string("Could not get variable ") + varName + std::string(" from result file."), Util::LC_CTR, Util::LL_ERROR);
-        //            else
-        //                omc_matlab4_val(res, reader, var, time);
-        //
-        //            return res;
-        //        }
-
         /*-----------------------------------------
          * CONSTRUCTORS
          *---------------------------------------*/
 
         VisualizerMAT::VisualizerMAT(const std::string& modelFile, const std::string& path)
                 : VisualizerAbstract(modelFile, path, VisType::MAT),
-                  _matReader()
+                  _matFile(),
+                  _batch(),
+                  _baked(),
+                  _prefetcher(nullptr)
         {
         }
 
@@ -57,10 +47,18 @@ namespace OMVIS
 
         void VisualizerMAT::initData()
         {
+            // The prefetcher reads from the MAT file, which is reopened.
+            _prefetcher.reset();
             VisualizerAbstract::initData();
             readMat(_baseData->getModelFile(), _baseData->getPath());
-            _timeManager->setStartTime(omc_matlab4_startTime(&_matReader));
-            _timeManager->setEndTime(omc_matlab4_stopTime(&_matReader));
+            bindVisAttributes();
+            _baked.open(Util::getBakeFileName(_baseData->getModelFile(), _baseData->getPath()),
+                        _baseData->getPath() + _baseData->getModelFile(), _baseData->getXMLFileName(),
+                        _baseData->_shapes.size());
+            _timeManager->setStartTime(_matFile.getStartTime());
+            _timeManager->setEndTime(_matFile.getStopTime());
+            if (!_baked.isOpen())
+                _prefetcher.reset(new MatPrefetcher(_matFile, _baseData->_shapes));
         }
 
         void VisualizerMAT::initializeVisAttributes(const double time)
@@ -86,22 +84,91 @@ namespace OMVIS
             }
             else
             {
-                // Read mat file.
-                auto ret = omc_new_matlab4_reader(resFileName.c_str(), &_matReader);
-                // Check return value.
-                if (nullptr != ret)
+                // Only load the variables that are visualized.
+                const ShapeTable& table = _baseData->_shapeTable;
+                std::vector<std::string> varNames;
+                varNames.reserve(table.getNumVariables());
+                for (std::size_t i = 0; i < table.getNumVariables(); ++i)
+                    varNames.push_back(table.getVariable(i));
+
+                // Map mat file. Throws if the file is not a valid result file.
+                _matFile.open(resFileName, varNames);
+            }
+        }
+
+        void VisualizerMAT::bindVisAttributes()
+        {
+            ShapeTable& table = _baseData->_shapeTable;
+            std::vector<std::size_t> unresolved;
+            _batch.clear();
+            for (std::size_t i = 0; i < table.getNumVariables(); ++i)
+            {
+                MatColumn column;
+                if (!_matFile.findVariable(table.getVariable(i), column))
                 {
-                    std::string msg(ret);
-                    LOGGER_WRITE(msg, Util::LC_LOADER, Util::LL_ERROR);
-                    throw std::runtime_error(msg);
+                    LOGGER_WRITE("Did not get variable from result file. Variable name is " + table.getVariable(i)
+                                 + ".", Util::LC_LOADER, Util::LL_ERROR);
+                    unresolved.push_back(i);
+                }
+                else
+                {
+                    _matFile.addToBatch(column, _batch);
                 }
             }
+            table.makeConst(unresolved, 0.0);
+            LOGGER_WRITE("Bound " + std::to_string(table.getNumVariables()) + " variables of the MAT file.",
+                         Util::LC_LOADER, Util::LL_DEBUG);
+        }
 
-            /*
-             FILE * fileA = fopen("allVArs.txt", "w+");
-             omc_matlab4_print_all_vars(fileA, &matReader);
-             fclose(fileA);
-             */
+        void VisualizerMAT::bake()
+        {
+            initData();
+            _baked.close();
+            _prefetcher.reset();
+
+            const std::string matFileName = _baseData->getPath() + _baseData->getModelFile();
+            const std::string bakeFileName = Util::getBakeFileName(_baseData->getModelFile(), _baseData->getPath());
+            std::ofstream out(bakeFileName, std::ios::binary | std::ios::trunc);
+            if (!out)
+            {
+                auto msg = "Could not open " + bakeFileName + " for writing.";
+                LOGGER_WRITE(msg, Util::LC_LOADER, Util::LL_ERROR);
+                throw std::runtime_error(msg);
+            }
+
+            auto& shapes = _baseData->_shapes;
+            ShapeTable& table = _baseData->_shapeTable;
+            const std::size_t numRows = _matFile.getNumRows();
+            const BakedHeader header = BakedTransforms::makeHeader(matFileName, _baseData->getXMLFileName(),
+                                                                   shapes.size(), numRows);
+            out.write(reinterpret_cast<const char*>(&header), sizeof(BakedHeader));
+            for (std::size_t row = 0; row < numRows; ++row)
+            {
+                const double time = _matFile.getTime(row);
+                out.write(reinterpret_cast<const char*>(&time), sizeof(double));
+            }
+
+            std::vector<BakedShape> frame(shapes.size());
+            for (std::size_t row = 0; row < numRows; ++row)
+            {
+                _matFile.seekRow(row);
+                _matFile.interpolate(_batch, table.getVariableValues());
+                table.scatter();
+                computeTransforms();
+                for (std::size_t i = 0; i < shapes.size(); ++i)
+                    BakedTransforms::record(shapes[i], frame[i]);
+                out.write(reinterpret_cast<const char*>(frame.data()), frame.size() * sizeof(BakedShape));
+            }
+
+            out.close();
+            if (!out)
+            {
+                auto msg = "Could not write baked transformation file " + bakeFileName + ".";
+                LOGGER_WRITE(msg, Util::LC_LOADER, Util::LL_ERROR);
+                throw std::runtime_error(msg);
+            }
+            LOGGER_WRITE("Baked " + std::to_string(numRows) + " frames of " + std::to_string(shapes.size())
+                         + " shapes to " + bakeFileName + ".", Util::LC_LOADER, Util::LL_INFO);
         }
 
         /*-----------------------------------------
@@ -110,74 +177,43 @@ namespace OMVIS
 
         void VisualizerMAT::updateVisAttributes(const double time)
         {
-            // Update all shapes.
-            unsigned int shapeIdx = 0;
-            OMVIS::Util::rAndT rT;
-            osg::ref_ptr<osg::Node> child = nullptr;
-            ModelicaMatReader* tmpReaderPtr = &_matReader;
             try
             {
-                for (auto& shape : _baseData->_shapes)
+                ShapeTable& table = _baseData->_shapeTable;
+                // Baked and prefetched frames already contain the transformations.
+                bool needsTransforms = false;
                 {
-                    // Get the values for the scene graph objects
-                    updateObjectAttributeMAT(&shape._length, time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._width, time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._height, time, tmpReaderPtr);
-
-                    updateObjectAttributeMAT(&shape._lDir[0], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._lDir[1], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._lDir[2], time, tmpReaderPtr);
-
-                    updateObjectAttributeMAT(&shape._wDir[0], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._wDir[1], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._wDir[2], time, tmpReaderPtr);
-
-                    updateObjectAttributeMAT(&shape._r[0], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._r[1], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._r[2], time, tmpReaderPtr);
-
-                    updateObjectAttributeMAT(&shape._rShape[0], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._rShape[1], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._rShape[2], time, tmpReaderPtr);
-
-                    updateObjectAttributeMAT(&shape._T[0], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._T[1], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._T[2], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._T[3], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._T[4], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._T[5], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._T[6], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._T[7], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._T[8], time, tmpReaderPtr);
-
-                    updateObjectAttributeMAT(&shape._color[0], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._color[1], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._color[2], time, tmpReaderPtr);
-
-                    updateObjectAttributeMAT(&shape._specCoeff, time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._extra, time, tmpReaderPtr);
-
-                    rT = Util::rotation(
-                            osg::Vec3f(shape._r[0].exp, shape._r[1].exp, shape._r[2].exp),
-                            osg::Vec3f(shape._rShape[0].exp, shape._rShape[1].exp, shape._rShape[2].exp),
-                            osg::Matrix3(shape._T[0].exp, shape._T[1].exp, shape._T[2].exp, shape._T[3].exp,
-                                         shape._T[4].exp, shape._T[5].exp, shape._T[6].exp, shape._T[7].exp,
-                                         shape._T[8].exp),
-                            osg::Vec3f(shape._lDir[0].exp, shape._lDir[1].exp, shape._lDir[2].exp),
-                            osg::Vec3f(shape._wDir[0].exp, shape._wDir[1].exp, shape._wDir[2].exp), shape._length.exp,
-                            shape._type);
-
-                    Util::assemblePokeMatrix(shape._mat, rT._T, rT._r);
-
-                    // Update the shapes.
-                    _nodeUpdater->_shape = shape;
-                    //shape.dumpVisAttributes();
-
-                    // Get the scene graph nodes and stuff.
-                    child = _viewerStuff->getScene()->getRootNode()->getChild(shapeIdx);  // the transformation
-                    child->accept(*_nodeUpdater);
-                    ++shapeIdx;
+                    Util::StageTimer fetchTimer(_frameTimes, Util::FS_FETCH);
+                    if (_baked.isOpen())
+                    {
+                        loadBakedFrame(time);
+                    }
+                    else if (_prefetcher && _prefetcher->pop(time, _baseData->_shapes, table))
+                    {
+                        // The shapes have been changed without the table.
+                        table.invalidateValues();
+                    }
+                    else
+                    {
+                        // Get the values for the scene graph objects. Constant attributes are not bound.
+                        _matFile.seek(time);
+                        _matFile.interpolate(_batch, table.getVariableValues());
+                        table.scatter();
+                        needsTransforms = true;
+                    }
                 }
+
+                if (needsTransforms)
+                {
+                    computeTransforms();
+
+                    // The playback has been started or interrupted. Prefetch the following frames.
+                    if (_prefetcher)
+                        _prefetcher->restart(time + _timeManager->getHVisual(), _timeManager->getHVisual());
+                }
+
+                // Update the shapes.
+                updateSceneNodes();
             }
             catch (std::exception& ex)
             {
@@ -188,6 +224,23 @@ namespace OMVIS
             }
         }
 
+        void VisualizerMAT::loadBakedFrame(const double time)
+        {
+            float weight;
+            const std::size_t row = _baked.findRow(time, weight);
+            const BakedShape* lo = _baked.getFrame(row);
+            const BakedShape* hi = (0.0f == weight) ? lo : _baked.getFrame(row + 1);
+            auto& shapes = _baseData->_shapes;
+            ShapeTable& table = _baseData->_shapeTable;
+            BakedShape rec;
+            for (std::size_t i = 0; i < shapes.size(); ++i)
+            {
+                BakedTransforms::interpolate(lo[i], hi[i], weight, rec);
+                if (BakedTransforms::restore(rec, shapes[i]))
+                    table.setDirty(i);
+            }
+        }
+
         void VisualizerMAT::updateScene(const double time)
         {
             if (0.0 > time)
@@ -206,33 +259,6 @@ namespace OMVIS
             _timeManager->setRealTimeFactor(_timeManager->getHVisual() / visTime);
         }
 
-        void VisualizerMAT::updateObjectAttributeMAT(Model::ShapeObjectAttribute* attr, double time,
-                                                     ModelicaMatReader* reader)
-        {
-            if (!attr->isConst)
-            {
-                attr->exp = omcGetVarValue(reader, attr->cref.c_str(), time);
-            }
-        }
-
-        double VisualizerMAT::omcGetVarValue(ModelicaMatReader* reader, const char* varName, double time)
-        {
-            double val = 0.0;
-            ModelicaMatVariable_t* var = nullptr;
-            var = omc_matlab4_find_var(reader, varName);
-            if (var == nullptr)
-            {
-                LOGGER_WRITE("Did not get variable from result file. Variable name is " + std::string(varName) + ".",
-                             Util::LC_SOLVER, Util::LL_ERROR);
-            }
-            else
-            {
-                omc_matlab4_val(&val, reader, var, time);
-            }
-
-            return val;
-        }
-
         void VisualizerMAT::setSimulationSettings(const Model::UserSimSettingsMAT& simSetMAT)
         {
             auto newVal = simSetMAT.speedup * _timeManager->getHVisual();
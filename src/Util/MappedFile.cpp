@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Util/MappedFile.hpp"
+
+#include <cstdint>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#endif
+
+namespace OMVIS
+{
+    namespace Util
+    {
+
+        namespace
+        {
+            std::uintptr_t getPageSize()
+            {
+#ifndef _WIN32
+                return static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+#else
+                SYSTEM_INFO info;
+                GetSystemInfo(&info);
+                return static_cast<std::uintptr_t>(info.dwPageSize);
+#endif
+            }
+        }
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        MappedFile::MappedFile()
+                : _data(nullptr),
+                  _size(0),
+                  _numReleases(0)
+#ifdef _WIN32
+                  ,
+                  _fileHandle(INVALID_HANDLE_VALUE),
+                  _mappingHandle(nullptr)
+#endif
+        {
+        }
+
+        MappedFile::~MappedFile()
+        {
+            close();
+        }
+
+        /*-----------------------------------------
+         * INITIALIZATION METHODS
+         *---------------------------------------*/
+
+        MappedFileStatus MappedFile::open(const std::string& fileName)
+        {
+            close();
+
+#ifndef _WIN32
+            int fd = ::open(fileName.c_str(), O_RDONLY);
+            if (0 > fd)
+                return MF_CANNOT_OPEN;
+
+            struct stat fileStat;
+            if (0 != fstat(fd, &fileStat) || 0 == fileStat.st_size)
+            {
+                ::close(fd);
+                return MF_EMPTY;
+            }
+
+            // The mapping stays valid after closing the descriptor.
+            void* addr = mmap(nullptr, static_cast<std::size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (MAP_FAILED == addr)
+                return MF_CANNOT_MAP;
+
+            _data = static_cast<const char*>(addr);
+            _size = static_cast<std::size_t>(fileStat.st_size);
+#else
+            HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                      FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (INVALID_HANDLE_VALUE == file)
+                return MF_CANNOT_OPEN;
+
+            LARGE_INTEGER fileSize;
+            if (!GetFileSizeEx(file, &fileSize) || 0 == fileSize.QuadPart)
+            {
+                CloseHandle(file);
+                return MF_EMPTY;
+            }
+
+            HANDLE mapping = CreateFileMapping(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            void* addr = (nullptr != mapping) ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+            if (nullptr == addr)
+            {
+                if (nullptr != mapping)
+                    CloseHandle(mapping);
+                CloseHandle(file);
+                return MF_CANNOT_MAP;
+            }
+
+            _fileHandle = file;
+            _mappingHandle = mapping;
+            _data = static_cast<const char*>(addr);
+            _size = static_cast<std::size_t>(fileSize.QuadPart);
+#endif
+            return MF_OK;
+        }
+
+        void MappedFile::close()
+        {
+            if (nullptr != _data)
+            {
+#ifndef _WIN32
+                munmap(const_cast<char*>(_data), _size);
+#else
+                UnmapViewOfFile(_data);
+                CloseHandle(_mappingHandle);
+                CloseHandle(_fileHandle);
+                _mappingHandle = nullptr;
+                _fileHandle = INVALID_HANDLE_VALUE;
+#endif
+            }
+
+            _data = nullptr;
+            _size = 0;
+            _numReleases = 0;
+        }
+
+        /*-----------------------------------------
+         * SIMULATION METHODS
+         *---------------------------------------*/
+
+        void MappedFile::adviseSequential()
+        {
+#ifndef _WIN32
+            if (nullptr != _data)
+                madvise(const_cast<char*>(_data), _size, MADV_SEQUENTIAL);
+#endif
+        }
+
+        void MappedFile::adviseRandom()
+        {
+#ifndef _WIN32
+            if (nullptr != _data)
+                madvise(const_cast<char*>(_data), _size, MADV_RANDOM);
+#endif
+        }
+
+        void MappedFile::release(const char* begin, const char* end)
+        {
+            const std::uintptr_t pageSize = getPageSize();
+            const std::uintptr_t first = (reinterpret_cast<std::uintptr_t>(begin) + pageSize - 1) & ~(pageSize - 1);
+            const std::uintptr_t last = reinterpret_cast<std::uintptr_t>(end) & ~(pageSize - 1);
+            if (first >= last)
+                return;
+
+#ifndef _WIN32
+            madvise(reinterpret_cast<void*>(first), last - first, MADV_DONTNEED);
+#else
+            // Unlocking pages which are not locked removes them from the working set.
+            VirtualUnlock(reinterpret_cast<void*>(first), last - first);
+#endif
+            ++_numReleases;
+        }
+
+    }  // namespace Util
+}  // namespace OMVIS
@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Util/StageStatistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace OMVIS
+{
+    namespace Util
+    {
+
+        /*-----------------------------------------
+         * StageHistogram
+         *---------------------------------------*/
+
+        constexpr std::size_t StageHistogram::subBuckets;
+        constexpr std::size_t StageHistogram::octaves;
+        constexpr std::size_t StageHistogram::numBuckets;
+
+        StageHistogram::StageHistogram()
+                : _counts(),
+                  _numSamples(0)
+        {
+            _counts.fill(0);
+        }
+
+        std::size_t StageHistogram::getNumSamples() const
+        {
+            return _numSamples;
+        }
+
+        double StageHistogram::getPercentile(const double fraction, const StageHistogram& other) const
+        {
+            const std::size_t numSamples = _numSamples + other._numSamples;
+            if (0 == numSamples)
+                return 0.0;
+
+            // The rank of the sample, which is the first one at or above the percentile.
+            const double rank = std::ceil(std::min(std::max(fraction, 0.0), 1.0) * numSamples);
+            const std::size_t target = std::max<std::size_t>(1, static_cast<std::size_t>(rank));
+            std::size_t count = 0;
+            std::size_t bucket = 0;
+            for (; bucket < numBuckets - 1; ++bucket)
+            {
+                count += _counts[bucket] + other._counts[bucket];
+                if (count >= target)
+                    break;
+            }
+            // Upper bound of the bucket in seconds.
+            return 1.e-6 * std::exp2(static_cast<double>(bucket + 1) / subBuckets);
+        }
+
+        void StageHistogram::add(const double seconds)
+        {
+            const double microseconds = 1.e6 * seconds;
+            std::size_t bucket = 0;
+            if (1.0 < microseconds)
+            {
+                const double index = std::floor(subBuckets * std::log2(microseconds));
+                bucket = std::min(static_cast<std::size_t>(index), numBuckets - 1);
+            }
+            ++_counts[bucket];
+            ++_numSamples;
+        }
+
+        void StageHistogram::clear()
+        {
+            _counts.fill(0);
+            _numSamples = 0;
+        }
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        namespace
+        {
+            //! Ids of the statistics, 0 marks a thread without ring.
+            std::atomic<std::uint64_t> nextId(1);
+        }
+
+        StageStatistics::StageStatistics(const double windowLength)
+                : _id(nextId.fetch_add(1)),
+                  _ringsMutex(),
+                  _rings(),
+                  _numDropped(0),
+                  _windowLength(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                          std::chrono::duration<double>(windowLength))),
+                  _windowStart(std::chrono::steady_clock::now()),
+                  _current(),
+                  _previous()
+        {
+        }
+
+        StageStatistics& StageStatistics::getInstance()
+        {
+            static StageStatistics instance;
+            return instance;
+        }
+
+        /*-----------------------------------------
+         * GETTERS and SETTERS
+         *---------------------------------------*/
+
+        double StageStatistics::getPercentile(const FrameStage stage, const double fraction) const
+        {
+            return _current[stage].getPercentile(fraction, _previous[stage]);
+        }
+
+        std::size_t StageStatistics::getNumSamples(const FrameStage stage) const
+        {
+            return _current[stage].getNumSamples() + _previous[stage].getNumSamples();
+        }
+
+        std::size_t StageStatistics::getNumDropped() const
+        {
+            return _numDropped.load(std::memory_order_relaxed);
+        }
+
+        std::size_t StageStatistics::getNumRings() const
+        {
+            std::lock_guard<std::mutex> lock(_ringsMutex);
+            return _rings.size();
+        }
+
+        /*-----------------------------------------
+         * SIMULATION METHODS
+         *---------------------------------------*/
+
+        void StageStatistics::record(const FrameStage stage, const double seconds)
+        {
+            Ring& ring = getLocalRing();
+            const std::size_t head = ring.head.load(std::memory_order_relaxed);
+            if (head - ring.tail.load(std::memory_order_acquire) >= ringSize)
+            {
+                _numDropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            ring.samples[head % ringSize] = { static_cast<float>(seconds), static_cast<std::uint32_t>(stage) };
+            ring.head.store(head + 1, std::memory_order_release);
+        }
+
+        void StageStatistics::record(const FrameTimes& times)
+        {
+            for (std::size_t stage = 0; stage < FS_NUM; ++stage)
+            {
+                if (0.0 < times[stage])
+                    record(static_cast<FrameStage>(stage), times[stage]);
+            }
+        }
+
+        void StageStatistics::collect()
+        {
+            const auto now = std::chrono::steady_clock::now();
+            if (now - _windowStart >= _windowLength)
+            {
+                // Start a new window. If the last one is long gone, its samples are outdated as well.
+                _previous = _current;
+                if (now - _windowStart >= 2 * _windowLength)
+                    std::for_each(_previous.begin(), _previous.end(), [](StageHistogram& h) { h.clear(); });
+                std::for_each(_current.begin(), _current.end(), [](StageHistogram& h) { h.clear(); });
+                _windowStart = now;
+            }
+
+            std::lock_guard<std::mutex> lock(_ringsMutex);
+            for (auto& ring : _rings)
+            {
+                const std::size_t tail = ring->tail.load(std::memory_order_relaxed);
+                const std::size_t head = ring->head.load(std::memory_order_acquire);
+                for (std::size_t i = tail; i < head; ++i)
+                {
+                    const Sample& sample = ring->samples[i % ringSize];
+                    if (FS_NUM > sample.stage)
+                        _current[sample.stage].add(sample.seconds);
+                }
+                ring->tail.store(head, std::memory_order_release);
+            }
+        }
+
+        void StageStatistics::reset()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_ringsMutex);
+                for (auto& ring : _rings)
+                    ring->tail.store(ring->head.load(std::memory_order_acquire), std::memory_order_release);
+            }
+            std::for_each(_current.begin(), _current.end(), [](StageHistogram& h) { h.clear(); });
+            std::for_each(_previous.begin(), _previous.end(), [](StageHistogram& h) { h.clear(); });
+            _numDropped.store(0, std::memory_order_relaxed);
+            _windowStart = std::chrono::steady_clock::now();
+        }
+
+        /*-----------------------------------------
+         * PRIVATE METHODS
+         *---------------------------------------*/
+
+        StageStatistics::Ring& StageStatistics::getLocalRing()
+        {
+            // The cached ring belongs to the statistics with the given id. Ids are not reused, unlike addresses.
+            thread_local RingLease lease;
+            if (_id != lease.owner)
+            {
+                lease.release();
+                std::lock_guard<std::mutex> lock(_ringsMutex);
+                // Take the ring of an exited thread. Its samples, which have not been collected yet, are kept.
+                auto it = std::find_if(_rings.begin(), _rings.end(), [](const std::shared_ptr<Ring>& ring)
+                {
+                    return !ring->inUse.load(std::memory_order_acquire);
+                });
+                if (_rings.end() == it)
+                    it = _rings.insert(_rings.end(), std::make_shared<Ring>());
+                (*it)->inUse.store(true, std::memory_order_relaxed);
+                lease.ring = *it;
+                lease.owner = _id;
+            }
+            return *lease.ring;
+        }
+
+    }  // namespace Util
+}  // namespace OMVIS
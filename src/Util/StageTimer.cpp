@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Util/StageTimer.hpp"
+
+namespace OMVIS
+{
+    namespace Util
+    {
+
+        const char* getFrameStageName(const FrameStage stage)
+        {
+            switch (stage)
+            {
+                case FS_INPUT:
+                    return "input";
+                case FS_SIMULATE:
+                    return "simulate";
+                case FS_FETCH:
+                    return "fetch";
+                case FS_TRANSFORM:
+                    return "transform";
+                case FS_APPLY:
+                    return "apply";
+                case FS_RENDER:
+                    return "render";
+                default:
+                    return "unknown";
+            }
+        }
+
+    }  // namespace Util
+}  // namespace OMVIS
@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Util/ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace OMVIS
+{
+    namespace Util
+    {
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        ThreadPool::ThreadPool(const std::size_t numWorkers)
+                : _workers(),
+                  _mutex(),
+                  _wakeUp(),
+                  _done(),
+                  _func(nullptr),
+                  _context(nullptr),
+                  _size(0),
+                  _grainSize(1),
+                  _next(0),
+                  _error(nullptr),
+                  _loop(0),
+                  _busy(0),
+                  _stop(false)
+        {
+            _workers.reserve(numWorkers);
+            for (std::size_t i = 0; i < numWorkers; ++i)
+                _workers.emplace_back(&ThreadPool::run, this);
+        }
+
+        ThreadPool::~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop = true;
+            }
+            _wakeUp.notify_all();
+            for (auto& worker : _workers)
+                worker.join();
+        }
+
+        /*-----------------------------------------
+         * GETTERS and SETTERS
+         *---------------------------------------*/
+
+        std::size_t ThreadPool::getNumThreads() const
+        {
+            return _workers.size() + 1;
+        }
+
+        std::size_t ThreadPool::defaultNumWorkers()
+        {
+            const unsigned int numThreads = std::thread::hardware_concurrency();
+            return (1 < numThreads) ? numThreads - 1 : 0;
+        }
+
+        /*-----------------------------------------
+         * SIMULATION METHODS
+         *---------------------------------------*/
+
+        void ThreadPool::parallelFor(const std::size_t size, const std::size_t grainSize, const ChunkFunction func,
+                                     const void* context)
+        {
+            if (0 == size)
+                return;
+
+            // Waking the workers does not pay off for a single chunk.
+            if (_workers.empty() || size <= grainSize)
+            {
+                func(context, 0, size);
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _func = func;
+                _context = context;
+                _size = size;
+                _grainSize = std::max<std::size_t>(grainSize, 1);
+                _next = 0;
+                _error = nullptr;
+                _busy = _workers.size();
+                ++_loop;
+            }
+            _wakeUp.notify_all();
+
+            work();
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            _done.wait(lock, [this]
+            {
+                return 0 == _busy;
+            });
+            _func = nullptr;
+            _context = nullptr;
+            if (_error)
+                std::rethrow_exception(_error);
+        }
+
+        /*-----------------------------------------
+         * PRIVATE METHODS
+         *---------------------------------------*/
+
+        void ThreadPool::run()
+        {
+            std::size_t loop = 0;
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (true)
+            {
+                _wakeUp.wait(lock, [&]
+                {
+                    return _stop || loop != _loop;
+                });
+                if (_stop)
+                    return;
+
+                loop = _loop;
+                lock.unlock();
+                work();
+                lock.lock();
+
+                if (0 == --_busy)
+                    _done.notify_one();
+            }
+        }
+
+        void ThreadPool::work()
+        {
+            while (true)
+            {
+                const std::size_t begin = _next.fetch_add(_grainSize);
+                if (begin >= _size)
+                    return;
+
+                try
+                {
+                    _func(_context, begin, std::min(begin + _grainSize, _size));
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (!_error)
+                        _error = std::current_exception();
+                    _next = _size;
+                }
+            }
+        }
+
+    }  // namespace Util
+}  // namespace OMVIS
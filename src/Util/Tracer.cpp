@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Util/Tracer.hpp"
+#include "Util/Logger.hpp"
+
+#include <iomanip>
+#include <stdexcept>
+
+namespace OMVIS
+{
+    namespace Util
+    {
+
+        namespace
+        {
+            //! Ids of the threads in the trace. The id 0 is not used by the viewers.
+            std::atomic<std::uint32_t> nextThreadId(1);
+
+            //! Initial capacity of the event buffers.
+            const std::size_t bufferSize = 4096;
+        }
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        Tracer::Tracer()
+                : _enabled(false),
+                  _origin(std::chrono::steady_clock::now()),
+                  _mutex(),
+                  _condition(),
+                  _pending(),
+                  _stopping(false),
+                  _writer(),
+                  _writing(),
+                  _file(),
+                  _firstEvent(true)
+        {
+        }
+
+        Tracer::~Tracer()
+        {
+            stop();
+        }
+
+        Tracer& Tracer::getInstance()
+        {
+            static Tracer instance;
+            return instance;
+        }
+
+        /*-----------------------------------------
+         * INITIALIZATION METHODS
+         *---------------------------------------*/
+
+        void Tracer::start(const std::string& fileName)
+        {
+            stop();
+
+            _file.open(fileName, std::ios::out | std::ios::trunc);
+            if (!_file.is_open())
+            {
+                const std::string msg = "Cannot open the trace file " + fileName + ".";
+                LOGGER_WRITE(msg, Util::LC_OTHER, Util::LL_ERROR);
+                throw std::runtime_error(msg);
+            }
+            _file << std::fixed << std::setprecision(3);
+            _file << "{\"traceEvents\":[\n"
+                  << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"OMVIS\"}}";
+            _firstEvent = false;
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _pending.clear();
+                _pending.reserve(bufferSize);
+                _stopping = false;
+            }
+            _writing.reserve(bufferSize);
+            _origin = std::chrono::steady_clock::now();
+            _writer = std::thread(&Tracer::runWriter, this);
+            _enabled.store(true);
+            LOGGER_WRITE("Tracing to " + fileName + ".", Util::LC_OTHER, Util::LL_INFO);
+        }
+
+        void Tracer::stop()
+        {
+            if (!_writer.joinable())
+                return;
+
+            _enabled.store(false);
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stopping = true;
+            }
+            _condition.notify_one();
+            _writer.join();
+
+            _file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+            _file.close();
+            _firstEvent = true;
+        }
+
+        /*-----------------------------------------
+         * SIMULATION METHODS
+         *---------------------------------------*/
+
+        void Tracer::record(const char* name, const char* category, const std::int64_t begin, const std::int64_t end)
+        {
+            if (!isEnabled())
+                return;
+
+            thread_local const std::uint32_t threadId = nextThreadId.fetch_add(1);
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_stopping)
+                _pending.push_back({ name, category, threadId, begin, end - begin });
+        }
+
+        /*-----------------------------------------
+         * PRIVATE METHODS
+         *---------------------------------------*/
+
+        void Tracer::runWriter()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (true)
+            {
+                _condition.wait_for(lock, std::chrono::milliseconds(100), [this]() { return _stopping; });
+                _pending.swap(_writing);
+                const bool stopping = _stopping;
+                lock.unlock();
+
+                writeEvents(_writing);
+                _writing.clear();
+                _file.flush();
+                if (stopping)
+                    return;
+                lock.lock();
+            }
+        }
+
+        void Tracer::writeEvents(const std::vector<Event>& events)
+        {
+            for (const Event& event : events)
+            {
+                _file << (_firstEvent ? "\n" : ",\n") << "{\"name\":\"" << event.name << "\",\"cat\":\""
+                      << event.category << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadId << ",\"ts\":"
+                      << 1.e-3 * event.begin << ",\"dur\":" << 1.e-3 * event.duration << "}";
+                _firstEvent = false;
+            }
+        }
+
+    }  // namespace Util
+}  // namespace OMVIS
@@ -0,0 +1,270 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Util/TransformKernel.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace OMVIS
+{
+    namespace Util
+    {
+
+        namespace
+        {
+            /*! \brief The operations of the kernel on a single float. */
+            struct ScalarLane
+            {
+                using Vec = float;
+                using Mask = bool;
+                static constexpr std::size_t width = 1;
+
+                static Vec set(const float x) { return x; }
+                static Vec load(const float* p) { return *p; }
+                static void store(float* p, const Vec a) { *p = a; }
+                static Vec sqrt(const Vec a) { return std::sqrt(a); }
+                static Vec max(const Vec a, const Vec b) { return std::max(a, b); }
+                static Vec abs(const Vec a) { return std::fabs(a); }
+                static Mask less(const Vec a, const Vec b) { return a < b; }
+                static Vec select(const Mask m, const Vec a, const Vec b) { return m ? a : b; }
+            };
+
+#ifdef __AVX2__
+            /*! \brief The operations of the kernel on eight floats. The arithmetic operators of __m256 are provided
+             *         by the compiler.
+             */
+            struct AvxLane
+            {
+                using Vec = __m256;
+                using Mask = __m256;
+                static constexpr std::size_t width = 8;
+
+                static Vec set(const float x) { return _mm256_set1_ps(x); }
+                static Vec load(const float* p) { return _mm256_loadu_ps(p); }
+                static void store(float* p, const Vec a) { _mm256_storeu_ps(p, a); }
+                static Vec sqrt(const Vec a) { return _mm256_sqrt_ps(a); }
+                static Vec max(const Vec a, const Vec b) { return _mm256_max_ps(a, b); }
+                static Vec abs(const Vec a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+                static Mask less(const Vec a, const Vec b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+                static Vec select(const Mask m, const Vec a, const Vec b) { return _mm256_blendv_ps(b, a, m); }
+            };
+#endif
+
+            template <typename L>
+            void cross(const typename L::Vec* a, const typename L::Vec* b, typename L::Vec* c)
+            {
+                c[0] = a[1] * b[2] - a[2] * b[1];
+                c[1] = a[2] * b[0] - a[0] * b[2];
+                c[2] = a[0] * b[1] - a[1] * b[0];
+            }
+
+            template <typename L>
+            typename L::Vec dot(const typename L::Vec* a, const typename L::Vec* b)
+            {
+                return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+            }
+
+            /*! \brief Computes the matrices of the shapes [i, i + L::width). */
+            template <typename L>
+            void transformLanes(const TransformInputs& in, const std::size_t i, double* matrices)
+            {
+                using Vec = typename L::Vec;
+                using Mask = typename L::Mask;
+                const Vec zero = L::set(0.0f);
+                const Vec one = L::set(1.0f);
+                const Vec half = L::set(0.5f);
+
+                // Length direction, e_x of the shape. Falls back to the x axis, if lDir vanishes.
+                Vec l[3], eX[3];
+                for (int k = 0; k < 3; ++k)
+                    l[k] = L::load(in.lDir[k] + i);
+                const Vec lLength = L::sqrt(dot<L>(l, l));
+                const Mask lVanishes = L::less(lLength, L::set(1.e-10f));
+                const Vec lInv = one / L::max(lLength, L::set(1.e-10f));
+                eX[0] = L::select(lVanishes, one, l[0] * lInv);
+                eX[1] = L::select(lVanishes, zero, l[1] * lInv);
+                eX[2] = L::select(lVanishes, zero, l[2] * lInv);
+
+                // Width direction. Falls back to the x or y axis, if wDir is parallel to e_x.
+                Vec w[3], n[3], aux[3];
+                for (int k = 0; k < 3; ++k)
+                    w[k] = L::load(in.wDir[k] + i);
+                cross<L>(eX, w, n);
+                const Mask wValid = L::less(L::set(1.e-6f), dot<L>(n, n));
+                const Mask useY = L::less(L::set(1.e-6f), L::abs(eX[0]));
+                aux[0] = L::select(wValid, w[0], L::select(useY, zero, one));
+                aux[1] = L::select(wValid, w[1], L::select(useY, one, zero));
+                aux[2] = L::select(wValid, w[2], zero);
+
+                // e_y = normalize(e_x x aux) x e_x and e_z = e_x x e_y.
+                Vec c[3], eY[3], eZ[3];
+                cross<L>(eX, aux, c);
+                const Vec cLength = L::sqrt(dot<L>(c, c));
+                const Vec cInv = L::select(L::less(cLength, L::set(1.e-13f)), L::set(1.e-17f),
+                                           one / L::max(cLength, L::set(1.e-13f)));
+                for (int k = 0; k < 3; ++k)
+                    c[k] = c[k] * cInv;
+                cross<L>(c, eX, eY);
+                cross<L>(eX, eY, eZ);
+
+                // Rows of the shape orientation T0.
+                const Mask sphere = L::less(half, L::load(in.coefficients[TC_SPHERE] + i));
+                Vec rows[3][3];
+                for (int k = 0; k < 3; ++k)
+                {
+                    rows[0][k] = L::select(sphere, eX[k], eY[k]);
+                    rows[1][k] = L::select(sphere, eY[k], eZ[k]);
+                    rows[2][k] = L::select(sphere, eZ[k], eX[k]);
+                }
+
+                // Rotation R = T0 * T or T.
+                Vec T[9], R[9];
+                for (int k = 0; k < 9; ++k)
+                    T[k] = L::load(in.T[k] + i);
+                const Mask orient = L::less(half, L::load(in.coefficients[TC_ORIENT] + i));
+                for (int row = 0; row < 3; ++row)
+                {
+                    for (int col = 0; col < 3; ++col)
+                    {
+                        const Vec rotated = rows[row][0] * T[col] + rows[row][1] * T[3 + col]
+                                + rows[row][2] * T[6 + col];
+                        R[row * 3 + col] = L::select(orient, rotated, T[row * 3 + col]);
+                    }
+                }
+
+                // Scale the local axes of unit primitives, i.e., the rows of R.
+                const Vec length = L::load(in.length + i);
+                const Vec width = L::load(in.width + i);
+                const Mask scale = L::less(half, L::load(in.coefficients[TC_SCALE] + i));
+                const Mask useHeight = L::less(half, L::load(in.coefficients[TC_HEIGHT] + i));
+                const Vec widthOrHeight = L::select(useHeight, L::load(in.height + i), width);
+                Vec s[3];
+                s[0] = L::select(scale, L::select(sphere, length, width), one);
+                s[1] = L::select(scale, L::select(sphere, length, widthOrHeight), one);
+                s[2] = L::select(scale, length, one);
+                for (int row = 0; row < 3; ++row)
+                {
+                    for (int col = 0; col < 3; ++col)
+                        R[row * 3 + col] = R[row * 3 + col] * s[row];
+                }
+
+                // Position (r_shape + offset * length * e_x) * T + r.
+                const Vec offset = L::load(in.coefficients[TC_OFFSET] + i) * length;
+                const Mask rotate = L::less(half, L::load(in.coefficients[TC_ROTATE] + i));
+                const Mask origin = L::less(half, L::load(in.coefficients[TC_ORIGIN] + i));
+                Vec p[3], pos[3];
+                for (int k = 0; k < 3; ++k)
+                    p[k] = L::load(in.rShape[k] + i) + eX[k] * offset;
+                for (int k = 0; k < 3; ++k)
+                {
+                    const Vec rotated = p[0] * T[k] + p[1] * T[3 + k] + p[2] * T[6 + k];
+                    pos[k] = L::select(rotate, rotated, p[k]);
+                    pos[k] = L::select(origin, pos[k] + L::load(in.r[k] + i), pos[k]);
+                }
+
+                // Assemble the matrices like assemblePokeMatrix.
+                float out[12 * L::width];
+                for (int k = 0; k < 9; ++k)
+                    L::store(out + k * L::width, R[k]);
+                for (int k = 0; k < 3; ++k)
+                    L::store(out + (9 + k) * L::width, pos[k]);
+
+                for (std::size_t lane = 0; lane < L::width; ++lane)
+                {
+                    double* M = matrices + 16 * (i + lane);
+                    for (int row = 0; row < 3; ++row)
+                    {
+                        for (int col = 0; col < 3; ++col)
+                            M[row * 4 + col] = out[(row * 3 + col) * L::width + lane];
+                        M[row * 4 + 3] = 0.0;
+                        M[12 + row] = out[(9 + row) * L::width + lane];
+                    }
+                    M[15] = 1.0;
+                }
+            }
+        }
+
+        void getTransformCoefficients(const Model::ShapeType type, float* values)
+        {
+            // Centred shapes, e.g., box and cylinder.
+            values[TC_OFFSET] = 0.5f;
+            values[TC_ORIENT] = 1.0f;
+            values[TC_SPHERE] = 0.0f;
+            values[TC_ROTATE] = 1.0f;
+            values[TC_ORIGIN] = 1.0f;
+            values[TC_SCALE] = 0.0f;
+            values[TC_HEIGHT] = 0.0f;
+
+            switch (type)
+            {
+                case Model::ShapeType::BOX:
+                    values[TC_SCALE] = 1.0f;
+                    values[TC_HEIGHT] = 1.0f;
+                    break;
+                case Model::ShapeType::CYLINDER:
+                    values[TC_SCALE] = 1.0f;
+                    break;
+                case Model::ShapeType::SPHERE:
+                    values[TC_SPHERE] = 1.0f;
+                    values[TC_SCALE] = 1.0f;
+                    break;
+                case Model::ShapeType::CAD:
+                    values[TC_OFFSET] = 0.0f;
+                    values[TC_ORIENT] = 0.0f;
+                    values[TC_ROTATE] = 0.0f;
+                    values[TC_ORIGIN] = 0.0f;
+                    break;
+                case Model::ShapeType::STL:
+                case Model::ShapeType::DXF:
+                    values[TC_OFFSET] = 0.0f;
+                    values[TC_ORIENT] = 0.0f;
+                    values[TC_ROTATE] = 0.0f;
+                    break;
+                case Model::ShapeType::CONE:
+                    values[TC_OFFSET] = 0.0f;
+                    values[TC_SCALE] = 1.0f;
+                    break;
+                case Model::ShapeType::PIPECYLINDER:
+                case Model::ShapeType::SPRING:
+                    values[TC_OFFSET] = 0.0f;
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        void transformBatch(const TransformInputs& in, const std::size_t begin, const std::size_t end,
+                            double* matrices)
+        {
+            std::size_t i = begin;
+#ifdef __AVX2__
+            for (; i + AvxLane::width <= end; i += AvxLane::width)
+                transformLanes<AvxLane>(in, i, matrices);
+#endif
+            for (; i < end; ++i)
+                transformLanes<ScalarLane>(in, i, matrices);
+        }
+
+    }  // namespace Util
+}  // namespace OMVIS
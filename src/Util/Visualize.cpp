@@ -188,18 +188,10 @@ namespace OMVIS
             return res;
         }
 
-
         /****************************
          * Extract Shape information
          *****************************/
 
-        void updateObjectAttributeFMUClient(Model::ShapeObjectAttribute& attr, const NetOff::ValueContainer& _outputCont)
-        {
-            if (!attr.isConst)
-                attr.exp = (float)(_outputCont.getRealValues()[attr.fmuValueRef]);
-                //attr.exp = reinterpret_cast<float>(_outputCont.getRealValues()[attr.fmuValueRef]);
-        }
-
         double getShapeAttrFMU(const char* attr, rapidxml::xml_node<>* node, double time, fmi1_import_t* fmu)
         {
             rapidxml::xml_node<>* expNode = node->first_node(attr)->first_node();
@@ -34,7 +34,8 @@ namespace OMVIS
          *---------------------------------------*/
 
         OpenFileDialog::OpenFileDialog(QWidget* parent)
-                : QFileDialog(parent, tr("Open Simulation File"), QString(), tr("Visualization FMU(*.fmu);; Visualization MAT(*.mat)")),
+                : QFileDialog(parent, tr("Open Simulation File"), QString(),
+                              tr("Visualization FMU(*.fmu);; Visualization MAT(*.mat);; Visualization CSV(*.csv)")),
                   _modelFile(),
                   _path()
         {
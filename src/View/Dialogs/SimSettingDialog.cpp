@@ -27,6 +27,7 @@
 #include <QMessageBox>
 #include <QString>
 
+#include <cmath>
 #include <iostream>
 
 namespace OMVIS
@@ -157,10 +158,12 @@ namespace OMVIS
             if (_speedupLineEdit->isModified())
             {
                 _simSet.speedup = _speedupLineEdit->text().toDouble();
-                if (1.0 > _simSet.speedup)
+                // Negative values play the result backwards.
+                if (1.0 > std::abs(_simSet.speedup))
                 {
-                    QMessageBox::warning(0, QString("Information"), QString("A speedup less than 1.0 is not valid."));
-                    _simSet.speedup = 1.0;
+                    QMessageBox::warning(0, QString("Information"),
+                                         QString("A speedup with an absolute value less than 1.0 is not valid."));
+                    _simSet.speedup = (0.0 > _simSet.speedup) ? -1.0 : 1.0;
                 }
             }
             QDialog::accept();
@@ -170,8 +173,10 @@ namespace OMVIS
         {
           QString information("A speedup greater than 1.0 means that<br>"
                                "the simulation runs faster and gives a <br>"
-                               "rough overview on the model behavior. <br><br>"
-                               "[A speedup less than 1.0 is not possible, <br>"
+                               "rough overview on the model behavior. <br>"
+                               "A negative speedup plays the result <br>"
+                               "backwards, e.g., -1.0 in real time. <br><br>"
+                               "[A speedup between -1.0 and 1.0 is not possible, <br>"
                                "since the result file does not provide <br>"
                                "enough (intermediate) data.]");
           QMessageBox msgBox(QMessageBox::Information, tr("Help"), information);
@@ -20,6 +20,9 @@
 #include "View/OMVISViewer.hpp"
 #include "View/Dialogs.hpp"
 #include "Util/Logger.hpp"
+#include "Control/KeyboardEventHandler.hpp"
+#include "Util/StageStatistics.hpp"
+#include "Util/Tracer.hpp"
 #include "Util/Algebra.hpp"
 #include "Initialization/VisualizationConstructionPlans.hpp"
 #include "Model/FMUWrapper.hpp"
@@ -84,6 +87,7 @@ namespace OMVIS
                   _simSettingsAct(nullptr),
                   _unloadAct(nullptr),
                   _sceneView(new osgViewer::View()),
+                  _statisticsOverlay(nullptr),
                   _osgViewerWidget(nullptr),
                   _controlElementWidget(nullptr),
                   _timeSlider(nullptr),
@@ -284,6 +288,11 @@ namespace OMVIS
 
             _sceneView->setSceneData(rootNode);
             _sceneView->addEventHandler(new osgViewer::StatsHandler());
+
+            // The statistics of the frame stages are shown next to the ones of the StatsHandler.
+            _statisticsOverlay = new StatisticsOverlay(gw.get());
+            _sceneView->addSlave(_statisticsOverlay.get(), false);
+            _sceneView->addEventHandler(new Control::KeyboardEventHandler(nullptr, _statisticsOverlay.get()));
             _sceneView->setCameraManipulator(new osgGA::MultiTouchTrackballManipulator());
             gw->setTouchEventsEnabled(true);
 
@@ -313,7 +322,13 @@ namespace OMVIS
 
         void OMVISViewer::paintEvent(QPaintEvent* /*event*/)
         {
-            frame();
+            Util::FrameTimes renderTimes = {};
+            {
+                Util::TraceScope trace("frame", "render");
+                Util::StageTimer renderTimer(renderTimes, Util::FS_RENDER);
+                frame();
+            }
+            Util::StageStatistics::getInstance().record(renderTimes);
         }
 
         void OMVISViewer::setupTimeSliderWidget()
@@ -438,7 +453,7 @@ namespace OMVIS
                     _sceneView->addEventHandler(kbEventHandler);
                     disableTimeSlider();
                 }
-                if (_guiController->visTypeIsMAT())
+                if (_guiController->visTypeIsMAT() || _guiController->visTypeIsCSV())
                 {
                     enableTimeSlider();
                 }
@@ -555,9 +570,9 @@ namespace OMVIS
                 msgBox.exec();
             }
             // If a result file is visualized, we cannot map keys to input variables.
-            else if (_guiController->visTypeIsMAT())
+            else if (_guiController->visTypeIsMAT() || _guiController->visTypeIsCSV())
             {
-                QString information("Input Mapping is not available for mat file visualization.");
+                QString information("Input Mapping is not available for result file visualization.");
                 QMessageBox msgBox(QMessageBox::Information, tr("Not Available"), information, QMessageBox::NoButton);
                 msgBox.setStandardButtons(QMessageBox::Close);
                 msgBox.exec();
@@ -755,7 +770,8 @@ namespace OMVIS
                         _visTimer.setInterval(simSetFMU.visStepSize);
                     }
                 }
-                else if (_guiController->visTypeIsMAT() || _guiController->visTypeIsMATRemote())
+                else if (_guiController->visTypeIsMAT() || _guiController->visTypeIsMATRemote()
+                        || _guiController->visTypeIsCSV())
                 {
                     SimSettingDialogMAT dialog(this);
                     if (0 != dialog.exec())
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "View/StatisticsOverlay.hpp"
+#include "Util/StageStatistics.hpp"
+
+#include <osg/Geode>
+#include <osg/NodeCallback>
+
+#include <iomanip>
+#include <sstream>
+
+namespace OMVIS
+{
+    namespace View
+    {
+
+        namespace
+        {
+            //! The overlay uses the same virtual screen as osgViewer::StatsHandler.
+            const double screenWidth = 1280.0;
+            const double screenHeight = 1024.0;
+            const float characterSize = 20.0f;
+
+            /*! \brief Refreshes the overlay in the update traversal, i.e., while the text is not drawn. */
+            class RefreshCallback : public osg::NodeCallback
+            {
+             public:
+                void operator()(osg::Node* node, osg::NodeVisitor* nv) override
+                {
+                    static_cast<StatisticsOverlay*>(node)->refresh();
+                    traverse(node, nv);
+                }
+            };
+
+            osg::ref_ptr<osgText::Text> createColumn(const float x)
+            {
+                osg::ref_ptr<osgText::Text> text = new osgText::Text();
+                text->setDataVariance(osg::Object::DYNAMIC);
+                text->setFont("fonts/arial.ttf");
+                text->setCharacterSize(characterSize);
+                text->setColor(osg::Vec4(1.0f, 1.0f, 0.0f, 1.0f));
+                text->setPosition(osg::Vec3(x, static_cast<float>(screenHeight) - 2.0f * characterSize, 0.0f));
+                return text;
+            }
+        }
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        StatisticsOverlay::StatisticsOverlay(osg::GraphicsContext* context)
+                : osg::Camera(),
+                  _names(createColumn(10.0f)),
+                  _medians(createColumn(10.0f + 7.0f * characterSize)),
+                  _tails(createColumn(10.0f + 13.0f * characterSize)),
+                  _lastRefresh()
+        {
+            setGraphicsContext(context);
+            if (nullptr != context && nullptr != context->getTraits())
+                setViewport(0, 0, context->getTraits()->width, context->getTraits()->height);
+            setReferenceFrame(osg::Transform::ABSOLUTE_RF);
+            setProjectionMatrix(osg::Matrix::ortho2D(0.0, screenWidth, 0.0, screenHeight));
+            setProjectionResizePolicy(osg::Camera::FIXED);
+            setViewMatrix(osg::Matrix::identity());
+            setClearMask(GL_DEPTH_BUFFER_BIT);
+            setRenderOrder(osg::Camera::POST_RENDER, 11);
+            setAllowEventFocus(false);
+            getOrCreateStateSet()->setMode(GL_LIGHTING, osg::StateAttribute::OFF);
+            getOrCreateStateSet()->setMode(GL_DEPTH_TEST, osg::StateAttribute::OFF);
+
+            osg::ref_ptr<osg::Geode> geode = new osg::Geode();
+            geode->addDrawable(_names.get());
+            geode->addDrawable(_medians.get());
+            geode->addDrawable(_tails.get());
+            addChild(geode.get());
+
+            setUpdateCallback(new RefreshCallback());
+            setNodeMask(0);
+        }
+
+        /*-----------------------------------------
+         * SIMULATION METHODS
+         *---------------------------------------*/
+
+        void StatisticsOverlay::refresh()
+        {
+            const auto now = std::chrono::steady_clock::now();
+            if (now - _lastRefresh < std::chrono::milliseconds(250))
+                return;
+            _lastRefresh = now;
+
+            Util::StageStatistics& statistics = Util::StageStatistics::getInstance();
+            statistics.collect();
+
+            std::ostringstream names, medians, tails;
+            names << "Stage\n";
+            medians << "p50 [ms]\n";
+            tails << "p99 [ms]\n";
+            medians << std::fixed << std::setprecision(3);
+            tails << std::fixed << std::setprecision(3);
+            for (std::size_t stage = 0; stage < Util::FS_NUM; ++stage)
+            {
+                const Util::FrameStage frameStage = static_cast<Util::FrameStage>(stage);
+                names << Util::getFrameStageName(frameStage) << "\n";
+                if (0 == statistics.getNumSamples(frameStage))
+                {
+                    medians << "-\n";
+                    tails << "-\n";
+                }
+                else
+                {
+                    medians << 1.e3 * statistics.getPercentile(frameStage, 0.5) << "\n";
+                    tails << 1.e3 * statistics.getPercentile(frameStage, 0.99) << "\n";
+                }
+            }
+            _names->setText(names.str());
+            _medians->setText(medians.str());
+            _tails->setText(tails.str());
+        }
+
+    }  // namespace View
+}  // namespace OMVIS
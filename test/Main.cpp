@@ -27,6 +27,18 @@
 #include "TestVisualizationConstructionPlans.hpp"
 #include "TestCommon.hpp"
 #include "TestTimeManager.hpp"
+#include "TestMatResultFile.hpp"
+#include "TestCsvResultFile.hpp"
+#include "TestTransformKernel.hpp"
+#include "TestFrameAllocations.hpp"
+#include "TestSyntheticModel.hpp"
+#include "TestStageStatistics.hpp"
+#include "TestTracer.hpp"
+#include "TestBakedTransforms.hpp"
+#include "TestMatPrefetcher.hpp"
+#include "TestThreadPool.hpp"
+#include "TestGeometryCache.hpp"
+#include "TestInstancedPrimitive.hpp"
 
 
 int main(int argc, char **argv)
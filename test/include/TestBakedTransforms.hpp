@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_INCLUDE_TESTBAKEDTRANSFORMS_HPP_
+#define TEST_INCLUDE_TESTBAKEDTRANSFORMS_HPP_
+
+#include "TestCommon.hpp"
+#include "Model/BakedTransforms.hpp"
+#include "Model/MatResultFile.hpp"
+#include "Model/VisualizerMAT.hpp"
+#include "Util/Util.hpp"
+#include <gtest/gtest.h>
+
+#include <boost/filesystem.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+/*! \brief Class to test the round trip of a baked transformation file of \ref Model::VisualizerMAT.
+ *
+ * The pendulum example is copied to the working directory, such that the baked file is not written into the
+ * examples.
+ */
+class TestBakedTransforms : public TestCommon
+{
+ public:
+    TestBakedTransforms()
+            : TestCommon("TestBakedTransforms_res.mat", "./")
+    {
+    }
+
+    void SetUp()
+    {
+        copyFile("examples/pendulum_res.mat", getMatFileName());
+        copyFile("examples/pendulum_visual.xml", getXMLFileName());
+    }
+
+    void TearDown()
+    {
+        std::remove(getMatFileName().c_str());
+        std::remove(getXMLFileName().c_str());
+        std::remove(getBakeFileName().c_str());
+    }
+
+    std::string getMatFileName() const
+    {
+        return constructionPlan->path + constructionPlan->modelFile;
+    }
+
+    std::string getXMLFileName() const
+    {
+        return OMVIS::Util::getXMLFileName(constructionPlan->modelFile, constructionPlan->path);
+    }
+
+    std::string getBakeFileName() const
+    {
+        return OMVIS::Util::getBakeFileName(constructionPlan->modelFile, constructionPlan->path);
+    }
+
+    static void copyFile(const std::string& from, const std::string& to)
+    {
+        std::ifstream in(from, std::ios::binary);
+        std::ofstream out(to, std::ios::binary);
+        out << in.rdbuf();
+    }
+
+    /*! \brief Updates the scene of the visualizer at the given time and returns the matrices of all shapes. */
+    static std::vector<osg::Matrix> getMatrices(OMVIS::Model::VisualizerMAT& visualizer, const double time)
+    {
+        visualizer.getTimeManager()->setPause(false);
+        visualizer.getTimeManager()->setVisTime(time);
+        visualizer.sceneUpdate();
+        std::vector<osg::Matrix> matrices;
+        for (const auto& shape : visualizer.getBaseData()->_shapes)
+            matrices.push_back(shape._mat);
+        return matrices;
+    }
+};
+
+/*!
+ * Test that the baked frames equal the computed transformations at the output times, that the baked visualizer
+ * interpolates between them and that a changed MAT or XML file invalidates the baked file.
+ */
+TEST_F (TestBakedTransforms, RoundTrip)
+{
+    OMVIS::Model::VisualizerMAT computed(constructionPlan->modelFile, constructionPlan->path);
+    computed.initialize();
+    {
+        OMVIS::Model::VisualizerMAT baker(constructionPlan->modelFile, constructionPlan->path);
+        baker.bake();
+    }
+
+    OMVIS::Model::MatResultFile matFile;
+    matFile.open(getMatFileName());
+    const std::size_t numShapes = computed.getBaseData()->_shapes.size();
+    OMVIS::Model::BakedTransforms baked;
+    ASSERT_TRUE(baked.open(getBakeFileName(), getMatFileName(), getXMLFileName(), numShapes));
+
+    for (const std::size_t row : { std::size_t(0), std::size_t(1), matFile.getNumRows() / 2, matFile.getNumRows() - 1 })
+    {
+        const std::vector<osg::Matrix> expected = getMatrices(computed, matFile.getTime(row));
+        const OMVIS::Model::BakedShape* frame = baked.getFrame(row);
+        for (std::size_t i = 0; i < numShapes; ++i)
+        {
+            for (int k = 0; k < 16; ++k)
+                EXPECT_NEAR(expected[i].ptr()[k], frame[i].mat[k], 1.e-5 * (1.0 + std::abs(expected[i].ptr()[k])));
+        }
+    }
+
+    // Between two output times, the baked frames are interpolated instead of snapping to the closer one.
+    {
+        OMVIS::Model::VisualizerMAT visualizer(constructionPlan->modelFile, constructionPlan->path);
+        visualizer.initialize();
+        const std::size_t row = matFile.getNumRows() / 3;
+        const double t0 = matFile.getTime(row);
+        const double t1 = matFile.getTime(row + 1);
+        const std::vector<osg::Matrix> mid = getMatrices(visualizer, t0 + 0.25 * (t1 - t0));
+        for (std::size_t i = 0; i < numShapes; ++i)
+        {
+            for (int k = 0; k < 16; ++k)
+            {
+                const float lo = baked.getFrame(row)[i].mat[k];
+                const float hi = baked.getFrame(row + 1)[i].mat[k];
+                EXPECT_NEAR(lo + 0.25f * (hi - lo), mid[i].ptr()[k], 1.e-5 * (1.0 + std::abs(lo)));
+            }
+        }
+    }
+
+    // The file belongs to a different number of shapes.
+    EXPECT_FALSE(baked.open(getBakeFileName(), getMatFileName(), getXMLFileName(), numShapes + 1));
+
+    // Touching the MAT or the XML file makes the baked file stale.
+    for (const std::string& fileName : { getXMLFileName(), getMatFileName() })
+    {
+        ASSERT_TRUE(baked.open(getBakeFileName(), getMatFileName(), getXMLFileName(), numShapes));
+        boost::filesystem::last_write_time(fileName, boost::filesystem::last_write_time(fileName) + 10);
+        EXPECT_FALSE(baked.open(getBakeFileName(), getMatFileName(), getXMLFileName(), numShapes));
+        EXPECT_FALSE(baked.isOpen());
+        {
+            OMVIS::Model::VisualizerMAT baker(constructionPlan->modelFile, constructionPlan->path);
+            baker.bake();
+        }
+    }
+}
+
+#endif /* TEST_INCLUDE_TESTBAKEDTRANSFORMS_HPP_ */
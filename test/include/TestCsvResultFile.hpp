@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_INCLUDE_TESTCSVRESULTFILE_HPP_
+#define TEST_INCLUDE_TESTCSVRESULTFILE_HPP_
+
+#include "Model/CsvResultFile.hpp"
+#include <gtest/gtest.h>
+
+#include <clocale>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+/*! \brief Class to test the CSV result file reader \ref Model::CsvResultFile.
+ *
+ * The test file holds 300 rows with time = 0.01 * row, x = 2 * time and a.T[1,1] = -time. The rows 100 and 101 have
+ * the same time, as it happens at events.
+ */
+class TestCsvResultFile : public ::testing::Test
+{
+ public:
+    const std::string _fileName;
+    OMVIS::Model::CsvResultFile _csvFile;
+
+    TestCsvResultFile()
+            : _fileName("TestCsvResultFile.csv"),
+              _csvFile()
+    {
+    }
+
+    void SetUp()
+    {
+        std::ofstream out(_fileName);
+        out << "\"time\",\"x\",\"a.T[1,1]\",\n";
+        for (int row = 0; row < 300; ++row)
+        {
+            double time = 0.01 * ((row > 100) ? row - 1 : row);
+            out << time << "," << 2.0 * time << "," << -time << ",\n";
+        }
+        out.close();
+        _csvFile.open(_fileName);
+    }
+
+    void TearDown()
+    {
+        _csvFile.close();
+        std::remove(_fileName.c_str());
+    }
+
+    ~TestCsvResultFile()
+    {
+    }
+};
+
+/*!
+ * Test that the header and the time axis of the result file are read correctly.
+ */
+TEST_F (TestCsvResultFile, TimeAxis)
+{
+    ASSERT_TRUE(_csvFile.isOpen());
+    EXPECT_EQ(300u, _csvFile.getNumRows());
+    EXPECT_DOUBLE_EQ(0.0, _csvFile.getStartTime());
+    EXPECT_DOUBLE_EQ(2.98, _csvFile.getStopTime());
+    EXPECT_DOUBLE_EQ(1.5, _csvFile.getTime(151));
+
+    std::size_t column = 0;
+    EXPECT_TRUE(_csvFile.findVariable("a.T[1,1]", column));
+    EXPECT_EQ(2u, column);
+    EXPECT_FALSE(_csvFile.findVariable("noSuchVariable", column));
+}
+
+/*!
+ * Test that the cursor interpolates correctly when moving forward, backward and jumping.
+ */
+TEST_F (TestCsvResultFile, Seek)
+{
+    const std::vector<std::size_t> columns = { 0, 1, 2 };
+    double lo[3];
+    double hi[3];
+    for (double t : { 0.0, 0.005, 0.013, 0.011, 0.995, 1.0, 1.005, 2.5, 0.7, 2.98 })
+    {
+        _csvFile.seek(t);
+        const std::size_t row = _csvFile.getCursorRow();
+        const double weight = _csvFile.getCursorWeight();
+        _csvFile.readRow(row, columns, lo);
+        _csvFile.readRow((0.0 == weight) ? row : row + 1, columns, hi);
+        EXPECT_NEAR(t, lo[0] + weight * (hi[0] - lo[0]), 1.e-12);
+        EXPECT_NEAR(2.0 * t, lo[1] + weight * (hi[1] - lo[1]), 1.e-12);
+        EXPECT_NEAR(-t, lo[2] + weight * (hi[2] - lo[2]), 1.e-12);
+    }
+
+    // Times outside of the result are clamped.
+    _csvFile.seek(100.0);
+    EXPECT_EQ(299u, _csvFile.getCursorRow());
+    EXPECT_DOUBLE_EQ(0.0, _csvFile.getCursorWeight());
+    _csvFile.seek(-1.0);
+    EXPECT_EQ(0u, _csvFile.getCursorRow());
+}
+
+/*!
+ * Test that the values are parsed independently of the decimal separator of the global locale.
+ */
+TEST_F (TestCsvResultFile, LocaleIndependent)
+{
+    const std::string numeric = std::setlocale(LC_NUMERIC, nullptr);
+    // Nothing to test, if no locale with a decimal comma is installed.
+    if (nullptr == std::setlocale(LC_NUMERIC, "de_DE.UTF-8") && nullptr == std::setlocale(LC_NUMERIC, "de_DE"))
+        return;
+
+    OMVIS::Model::CsvResultFile csvFile;
+    csvFile.open(_fileName);
+    std::setlocale(LC_NUMERIC, numeric.c_str());
+    EXPECT_DOUBLE_EQ(2.98, csvFile.getStopTime());
+    EXPECT_DOUBLE_EQ(1.5, csvFile.getTime(151));
+}
+
+/*!
+ * Test that a field, which is not a number as a whole, is rejected instead of being read as zero.
+ */
+TEST (TestCsvResultFileErrors, InvalidValue)
+{
+    const std::string fileName = "TestCsvResultFileErrors.csv";
+    {
+        std::ofstream out(fileName);
+        out << "\"time\",\"x\",\n0,1,\n0.5,abc,\n1.0x,2,\n";
+    }
+
+    OMVIS::Model::CsvResultFile csvFile;
+    EXPECT_THROW(csvFile.open(fileName), std::runtime_error);
+    EXPECT_FALSE(csvFile.isOpen());
+
+    {
+        std::ofstream out(fileName);
+        out << "\"time\",\"x\",\n0,1,\n0.5,abc,\n1.0,2,\n";
+    }
+    csvFile.open(fileName);
+    const std::vector<std::size_t> columns = { 1 };
+    double value = 0.0;
+    csvFile.readRow(0, columns, &value);
+    EXPECT_DOUBLE_EQ(1.0, value);
+    EXPECT_THROW(csvFile.readRow(1, columns, &value), std::runtime_error);
+
+    csvFile.close();
+    std::remove(fileName.c_str());
+}
+
+#endif /* TEST_INCLUDE_TESTCSVRESULTFILE_HPP_ */
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_INCLUDE_TESTFRAMEALLOCATIONS_HPP_
+#define TEST_INCLUDE_TESTFRAMEALLOCATIONS_HPP_
+
+#include "TestCommon.hpp"
+#include "Control/TimeManager.hpp"
+#include "Model/VisualizerCSV.hpp"
+#include "Model/VisualizerFMU.hpp"
+#include "Model/VisualizerMAT.hpp"
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+
+namespace
+{
+    //! Allocations are only counted while this is set.
+    std::atomic<bool> countAllocations(false);
+    std::atomic<std::size_t> numAllocations(0);
+}
+
+/*! \brief Replaces the global operator new of the test executable, such that the allocations can be counted. The
+ *         array versions and the sized delete forward to these by default.
+ */
+void* operator new(std::size_t size)
+{
+    if (countAllocations)
+        ++numAllocations;
+    void* ptr = std::malloc((0 == size) ? 1 : size);
+    if (nullptr == ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+/*! \brief Class to test that the frames of all visualizer types do not allocate heap memory once the scene has been
+ *         set up.
+ *
+ * The first frames are not counted, since they start the prefetching of the MAT file and fill the geometry cache.
+ * \ref OMVIS::Model::VisualizerFMUClient is not covered, since it needs a running simulation server. Apart from
+ * the network transfer, its frames use the same shape table, transformation and scene update as the other
+ * visualizers.
+ */
+class TestFrameAllocations : public TestCommon
+{
+ public:
+    const int _numWarmUpFrames;
+    const int _numFrames;
+
+    TestFrameAllocations()
+            : TestCommon("pendulum_res.mat", "./examples/"),
+              _numWarmUpFrames(3),
+              _numFrames(20)
+    {
+    }
+
+    /*! \brief Plays the visualization and returns the number of heap allocations of the frames after the warm-up. */
+    std::size_t countFrameAllocations(OMVIS::Model::VisualizerAbstract& visualizer)
+    {
+        visualizer.initialize();
+        visualizer.getTimeManager()->setPause(false);
+        for (int i = 0; i < _numWarmUpFrames; ++i)
+            visualizer.sceneUpdate();
+
+        numAllocations = 0;
+        countAllocations = true;
+        for (int i = 0; i < _numFrames; ++i)
+            visualizer.sceneUpdate();
+        countAllocations = false;
+        return numAllocations;
+    }
+};
+
+/*!
+ * Test that a frame of a MAT file does not allocate.
+ */
+TEST_F (TestFrameAllocations, VisualizerMAT)
+{
+    OMVIS::Model::VisualizerMAT visualizer(constructionPlan->modelFile, constructionPlan->path);
+    EXPECT_EQ(0u, countFrameAllocations(visualizer));
+}
+
+/*!
+ * Test that a frame of a CSV file does not allocate. The file moves the pendulum body on a circle, all other
+ * variables of the visual XML file are missing and thus constant.
+ */
+TEST_F (TestFrameAllocations, VisualizerCSV)
+{
+    const std::string csvFileName = "TestFrameAllocations_res.csv";
+    const std::string xmlFileName = "TestFrameAllocations_visual.xml";
+    {
+        std::ifstream in("examples/pendulum_visual.xml", std::ios::binary);
+        std::ofstream out(xmlFileName, std::ios::binary);
+        out << in.rdbuf();
+    }
+    {
+        std::ofstream out(csvFileName);
+        out << "\"time\",\"body.frame_a.r_0[1]\",\"body.frame_a.r_0[2]\",\n";
+        for (int row = 0; row <= 1000; ++row)
+        {
+            const double time = 0.01 * row;
+            out << time << "," << std::sin(time) << "," << -std::cos(time) << ",\n";
+        }
+    }
+
+    reset(csvFileName, "./");
+    {
+        OMVIS::Model::VisualizerCSV visualizer(constructionPlan->modelFile, constructionPlan->path);
+        EXPECT_EQ(0u, countFrameAllocations(visualizer));
+    }
+    std::remove(csvFileName.c_str());
+    std::remove(xmlFileName.c_str());
+}
+
+/*!
+ * Test that a frame of a FMU, i.e., the simulation steps and the update of the scene, does not allocate.
+ */
+TEST_F (TestFrameAllocations, VisualizerFMU)
+{
+    reset("BouncingBall.fmu", "./examples/");
+    OMVIS::Model::VisualizerFMU visualizer(constructionPlan->modelFile, constructionPlan->path);
+    EXPECT_EQ(0u, countFrameAllocations(visualizer));
+}
+
+#endif /* TEST_INCLUDE_TESTFRAMEALLOCATIONS_HPP_ */
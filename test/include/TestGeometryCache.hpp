@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_INCLUDE_TESTGEOMETRYCACHE_HPP_
+#define TEST_INCLUDE_TESTGEOMETRYCACHE_HPP_
+
+#include "Model/GeometryCache.hpp"
+#include "Model/Shapes/Pipecylinder.hpp"
+#include "Model/Shapes/Spring.hpp"
+#include <gtest/gtest.h>
+
+#include <osg/ref_ptr>
+
+/*! \brief Checks that both geometries have the same vertices. */
+static void expectSameVertices(const osg::Geometry& expected, const osg::Geometry& actual)
+{
+    const osg::Vec3Array* expectedVertices = dynamic_cast<const osg::Vec3Array*>(expected.getVertexArray());
+    const osg::Vec3Array* actualVertices = dynamic_cast<const osg::Vec3Array*>(actual.getVertexArray());
+    ASSERT_NE(nullptr, expectedVertices);
+    ASSERT_NE(nullptr, actualVertices);
+    ASSERT_EQ(expectedVertices->size(), actualVertices->size());
+    for (std::size_t i = 0; i < expectedVertices->size(); ++i)
+    {
+        for (int k = 0; k < 3; ++k)
+            EXPECT_NEAR((*expectedVertices)[i][k], (*actualVertices)[i][k], 1.e-5) << "vertex " << i;
+    }
+}
+
+/*!
+ * Test that geometries with equal quantized parameters are shared and other parameters give new geometries.
+ */
+TEST (TestGeometryCache, SharesEqualGeometries)
+{
+    OMVIS::Model::GeometryCache cache;
+
+    osg::Geometry* pipe = cache.getPipecylinder(0.1f, 0.2f, 1.0f);
+    EXPECT_EQ(pipe, cache.getPipecylinder(0.1f, 0.2f, 1.0f));
+    EXPECT_EQ(pipe, cache.getPipecylinder(0.1f, 0.2f, 1.0f + 0.1f * OMVIS::Model::GeometryCache::quantum));
+    EXPECT_NE(pipe, cache.getPipecylinder(0.1f, 0.2f, 2.0f));
+    EXPECT_EQ(osg::Object::STATIC, pipe->getDataVariance());
+
+    osg::Geometry* spring = cache.getSpring(0.1f, 0.01f, 5.0f, 1.0f);
+    EXPECT_EQ(spring, cache.getSpring(0.1f, 0.01f, 5.0f, 1.0f));
+    EXPECT_NE(spring, cache.getSpring(0.1f, 0.01f, 6.0f, 1.0f));
+    EXPECT_EQ(4u, cache.getSize());
+
+    // Geometries in use survive clearing the cache, but are not shared anymore.
+    osg::ref_ptr<osg::Geometry> used = pipe;
+    cache.clear();
+    EXPECT_EQ(0u, cache.getSize());
+    EXPECT_NE(used.get(), cache.getPipecylinder(0.1f, 0.2f, 1.0f));
+}
+
+/*!
+ * Test that changing the length in place gives the same vertices as a new geometry of that length.
+ */
+TEST (TestGeometryCache, SetLengthInPlace)
+{
+    osg::ref_ptr<OMVIS::Model::Pipecylinder> pipe = new OMVIS::Model::Pipecylinder(0.1f, 0.2f, 1.0f);
+    pipe->setLength(2.5f);
+    EXPECT_EQ(2.5f, pipe->getLength());
+    osg::ref_ptr<OMVIS::Model::Pipecylinder> freshPipe = new OMVIS::Model::Pipecylinder(0.1f, 0.2f, 2.5f);
+    expectSameVertices(*freshPipe, *pipe);
+
+    osg::ref_ptr<OMVIS::Model::Spring> spring = new OMVIS::Model::Spring(0.1f, 0.01f, 5.0f, 1.0f);
+    spring->setLength(0.4f);
+    EXPECT_EQ(0.4f, spring->getLength());
+    osg::ref_ptr<OMVIS::Model::Spring> freshSpring = new OMVIS::Model::Spring(0.1f, 0.01f, 5.0f, 0.4f);
+    expectSameVertices(*freshSpring, *spring);
+}
+
+#endif /* TEST_INCLUDE_TESTGEOMETRYCACHE_HPP_ */
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_INCLUDE_TESTINSTANCEDPRIMITIVE_HPP_
+#define TEST_INCLUDE_TESTINSTANCEDPRIMITIVE_HPP_
+
+#include "Model/OSGScene.hpp"
+#include "Model/Shapes/InstancedPrimitive.hpp"
+#include <gtest/gtest.h>
+
+#include <osg/Matrixd>
+
+#include <cmath>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+/*!
+ * Test that the per-instance arrays hold the rows of the matrices with the color components and that the bounding
+ * box covers all instances.
+ */
+TEST (TestInstancedPrimitive, InstanceDataAndBound)
+{
+    using OMVIS::Model::InstancedPrimitive;
+    osg::ref_ptr<InstancedPrimitive> primitive = new InstancedPrimitive(OMVIS::Model::ShapeType::BOX, 3);
+    EXPECT_EQ(3u, primitive->getNumInstances());
+    EXPECT_EQ(3u, primitive->getPrimitiveSet(0)->getNumInstances());
+
+    // The unit box [-0.5, 0.5]^3 is moved, scaled and rotated.
+    const std::vector<osg::Matrixd> matrices = {
+            osg::Matrixd::translate(1.0, 2.0, 3.0),
+            osg::Matrixd::scale(2.0, 4.0, 6.0) * osg::Matrixd::translate(-10.0, 0.0, 0.0),
+            osg::Matrixd::rotate(0.5 * M_PI, osg::Vec3d(0.0, 0.0, 1.0)) * osg::Matrixd::translate(0.0, 0.0, 10.0) };
+    const std::vector<osg::Vec4f> colors = { osg::Vec4f(1.0, 0.0, 0.0, 1.0), osg::Vec4f(0.0, 1.0, 0.0, 1.0),
+                                             osg::Vec4f(0.0, 0.0, 1.0, 0.5) };
+    for (std::size_t i = 0; i < matrices.size(); ++i)
+        primitive->setInstance(i, matrices[i], colors[i]);
+    primitive->dirtyInstances();
+
+    for (unsigned int row = 0; row < 4; ++row)
+    {
+        const osg::Vec4Array* data = dynamic_cast<const osg::Vec4Array*>(primitive->getVertexAttribArray(
+                InstancedPrimitive::firstAttribute + row));
+        ASSERT_NE(nullptr, data);
+        ASSERT_EQ(3u, data->size());
+        for (std::size_t i = 0; i < matrices.size(); ++i)
+        {
+            for (int col = 0; col < 3; ++col)
+                EXPECT_NEAR(matrices[i](row, col), (*data)[i][col], 1.e-6) << "instance " << i << ", row " << row;
+            EXPECT_EQ(colors[i][row], (*data)[i][3]);
+        }
+    }
+
+    const osg::BoundingBox bound = primitive->computeBoundingBox();
+    EXPECT_NEAR(-11.0, bound.xMin(), 1.e-5);
+    EXPECT_NEAR(1.5, bound.xMax(), 1.e-5);
+    EXPECT_NEAR(-2.0, bound.yMin(), 1.e-5);
+    EXPECT_NEAR(2.5, bound.yMax(), 1.e-5);
+    EXPECT_NEAR(-3.0, bound.zMin(), 1.e-5);
+    EXPECT_NEAR(10.5, bound.zMax(), 1.e-5);
+}
+
+/*!
+ * Test that the scene draws a primitive type instanced, if there are at least OSGScene::minInstances non-constant
+ * shapes of this type. Types with fewer shapes get a node per shape.
+ */
+TEST (TestInstancedPrimitive, SceneRouting)
+{
+    const std::size_t numSpheres = OMVIS::Model::OSGScene::minInstances;
+    const std::size_t numBoxes = OMVIS::Model::OSGScene::minInstances - 1;
+    std::vector<OMVIS::Model::ShapeObject> shapes(numSpheres + numBoxes);
+    for (std::size_t i = 0; i < shapes.size(); ++i)
+    {
+        auto& shape = shapes[i];
+        shape._type = (i < numSpheres) ? "sphere" : "box";
+        shape._shapeType = OMVIS::Model::getShapeTypeForString(shape._type);
+        shape._mat = osg::Matrixd::translate(static_cast<double>(i), 0.0, 0.0);
+        for (int k = 0; k < 3; ++k)
+            shape._color[k].exp = 255.0f;
+    }
+
+    OMVIS::Model::OSGScene scene;
+    const std::vector<OMVIS::Model::ShapeNodes> nodes = scene.setUpScene(shapes, {});
+    ASSERT_EQ(shapes.size(), nodes.size());
+
+    OMVIS::Model::InstancedPrimitive* spheres = nodes[0].instances;
+    ASSERT_NE(nullptr, spheres);
+    EXPECT_EQ(numSpheres, spheres->getNumInstances());
+    std::set<std::uint32_t> instances;
+    for (std::size_t i = 0; i < numSpheres; ++i)
+    {
+        EXPECT_EQ(spheres, nodes[i].instances);
+        EXPECT_EQ(nullptr, nodes[i].transform);
+        instances.insert(nodes[i].instance);
+    }
+    EXPECT_EQ(numSpheres, instances.size());
+    EXPECT_GT(numSpheres, *instances.rbegin());
+
+    for (std::size_t i = numSpheres; i < shapes.size(); ++i)
+    {
+        EXPECT_EQ(nullptr, nodes[i].instances);
+        EXPECT_NE(nullptr, nodes[i].transform);
+    }
+}
+
+#endif /* TEST_INCLUDE_TESTINSTANCEDPRIMITIVE_HPP_ */
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_INCLUDE_TESTMATPREFETCHER_HPP_
+#define TEST_INCLUDE_TESTMATPREFETCHER_HPP_
+
+#include "TestCommon.hpp"
+#include "Model/MatPrefetcher.hpp"
+#include "Model/VisualizerMAT.hpp"
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/*! \brief Class to test the background computation of frames by \ref Model::MatPrefetcher.
+ *
+ * The frames popped from the prefetcher are compared to the first frame of a second prefetcher, which is restarted
+ * at the time of every frame.
+ */
+class TestMatPrefetcher : public TestCommon
+{
+ public:
+    TestMatPrefetcher()
+            : TestCommon("pendulum_res.mat", "./examples/"),
+              _visualizer(nullptr),
+              _matFile(),
+              _shapes(),
+              _table(),
+              _h(0.0)
+    {
+    }
+
+    void SetUp()
+    {
+        // The visualizer makes the unresolved variables constant, as expected by the prefetcher.
+        _visualizer = std::make_shared<OMVIS::Model::VisualizerMAT>(constructionPlan->modelFile,
+                                                                    constructionPlan->path);
+        _visualizer->initialize();
+        _matFile.open(constructionPlan->path + constructionPlan->modelFile);
+        _shapes = _visualizer->getBaseData()->_shapes;
+        _table.build(_shapes);
+        _h = (_matFile.getStopTime() - _matFile.getStartTime()) / 200.0;
+    }
+
+    /*! \brief Pops the frame of the given time and waits for the producer, if it is not computed yet. */
+    bool waitAndPop(OMVIS::Model::MatPrefetcher& prefetcher, const double time,
+                    std::vector<OMVIS::Model::ShapeObject>& shapes)
+    {
+        for (int i = 0; i < 5000; ++i)
+        {
+            if (prefetcher.pop(time, shapes, _table))
+                return true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return false;
+    }
+
+    /*! \brief Waits until the ring of the prefetcher holds at least the given number of frames. */
+    static void waitForFrames(const OMVIS::Model::MatPrefetcher& prefetcher, const std::size_t numFrames)
+    {
+        for (int i = 0; i < 5000 && prefetcher.getNumFrames() < numFrames; ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ASSERT_LE(numFrames, prefetcher.getNumFrames());
+    }
+
+    /*! \brief Checks the shapes against a frame which is computed right after a restart at the given time. */
+    void expectFrame(const double time, const std::vector<OMVIS::Model::ShapeObject>& shapes)
+    {
+        OMVIS::Model::MatPrefetcher oracle(_matFile, _shapes);
+        std::vector<OMVIS::Model::ShapeObject> expected(_shapes);
+        oracle.restart(time, 0.0);
+        ASSERT_TRUE(waitAndPop(oracle, time, expected));
+        for (std::size_t i = 0; i < shapes.size(); ++i)
+        {
+            for (int k = 0; k < 16; ++k)
+                EXPECT_NEAR(expected[i]._mat.ptr()[k], shapes[i]._mat.ptr()[k], 1.e-6) << "time " << time;
+        }
+    }
+
+    std::shared_ptr<OMVIS::Model::VisualizerMAT> _visualizer;
+    OMVIS::Model::MatResultFile _matFile;
+    std::vector<OMVIS::Model::ShapeObject> _shapes;
+    OMVIS::Model::ShapeTable _table;
+    //! The visualization step size.
+    double _h;
+};
+
+/*!
+ * Test forward and reverse playback over more frames than fit into the ring. A time between two frames is not
+ * prefetched, but must not discard the following frames.
+ */
+TEST_F (TestMatPrefetcher, ForwardAndReverse)
+{
+    OMVIS::Model::MatPrefetcher prefetcher(_matFile, _shapes);
+    std::vector<OMVIS::Model::ShapeObject> shapes(_shapes);
+
+    for (const double step : { _h, -_h })
+    {
+        // Same accumulation of the time as the producer.
+        double time = (0.0 < step) ? _matFile.getStartTime() : _matFile.getStopTime();
+        prefetcher.restart(time, step);
+        for (int k = 0; k < 40; ++k)
+        {
+            ASSERT_TRUE(waitAndPop(prefetcher, time, shapes)) << "time " << time;
+            if (0 == k % 8)
+                expectFrame(time, shapes);
+            time += step;
+        }
+
+        waitForFrames(prefetcher, 2);
+        EXPECT_FALSE(prefetcher.pop(time + 0.5 * step, shapes, _table));
+        EXPECT_TRUE(prefetcher.pop(time + step, shapes, _table));
+        expectFrame(time + step, shapes);
+    }
+}
+
+/*!
+ * Test that a restart with a new speed, as done by the visualizer after changing the step size, is followed.
+ */
+TEST_F (TestMatPrefetcher, SpeedChange)
+{
+    OMVIS::Model::MatPrefetcher prefetcher(_matFile, _shapes);
+    std::vector<OMVIS::Model::ShapeObject> shapes(_shapes);
+
+    double time = _matFile.getStartTime();
+    prefetcher.restart(time, _h);
+    for (int k = 0; k < 5; ++k)
+    {
+        ASSERT_TRUE(waitAndPop(prefetcher, time, shapes));
+        time += _h;
+    }
+
+    const double step = 2.0 * _h;
+    prefetcher.restart(time, step);
+    ASSERT_TRUE(waitAndPop(prefetcher, time, shapes));
+    waitForFrames(prefetcher, 2);
+    // A frame for the former step size does not exist anymore.
+    EXPECT_FALSE(prefetcher.pop(time + _h, shapes, _table));
+    time += step;
+    for (int k = 0; k < 20; ++k)
+    {
+        ASSERT_TRUE(waitAndPop(prefetcher, time, shapes)) << "time " << time;
+        time += step;
+    }
+    expectFrame(time - step, shapes);
+}
+
+/*!
+ * Test that a restart invalidates the frames of the former playback generation.
+ */
+TEST_F (TestMatPrefetcher, RestartInvalidatesFrames)
+{
+    OMVIS::Model::MatPrefetcher prefetcher(_matFile, _shapes);
+    std::vector<OMVIS::Model::ShapeObject> shapes(_shapes);
+
+    const double startTime = _matFile.getStartTime();
+    prefetcher.restart(startTime, _h);
+    waitForFrames(prefetcher, 4);
+
+    // Jump forward. The frame at startTime + h has been prefetched before the restart.
+    prefetcher.restart(startTime + 10.0 * _h, _h);
+    EXPECT_FALSE(prefetcher.pop(startTime + _h, shapes, _table));
+    ASSERT_TRUE(waitAndPop(prefetcher, startTime + 10.0 * _h, shapes));
+    expectFrame(startTime + 10.0 * _h, shapes);
+
+    // Jump backwards in reverse direction over the prefetched frames.
+    waitForFrames(prefetcher, 4);
+    const double time = startTime + 12.0 * _h;
+    prefetcher.restart(time, -_h);
+    ASSERT_TRUE(waitAndPop(prefetcher, time, shapes));
+    expectFrame(time, shapes);
+    ASSERT_TRUE(waitAndPop(prefetcher, time - _h, shapes));
+    expectFrame(time - _h, shapes);
+}
+
+#endif /* TEST_INCLUDE_TESTMATPREFETCHER_HPP_ */
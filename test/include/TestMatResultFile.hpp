@@ -0,0 +1,367 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_INCLUDE_TESTMATRESULTFILE_HPP_
+#define TEST_INCLUDE_TESTMATRESULTFILE_HPP_
+
+#include "Model/MatResultFile.hpp"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    void writeMatHeader(std::ofstream& out, const std::int32_t type, const std::size_t mrows, const std::size_t ncols,
+                        const std::string& name)
+    {
+        const std::int32_t header[5] = { type, static_cast<std::int32_t>(mrows), static_cast<std::int32_t>(ncols), 0,
+                                         static_cast<std::int32_t>(name.size() + 1) };
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        out.write(name.c_str(), name.size() + 1);
+    }
+
+    /*! \brief An alias variable, which refers to a column of data_1 (data set 1) or data_2 (data set 2). A negative
+     *         column negates the values.
+     */
+    struct MatAlias
+    {
+        std::string name;
+        std::int32_t dataSet;
+        std::int32_t column;
+    };
+
+    /*! \brief Writes a transposed MAT v4 result file with the time and the given parameters in data_1 and the time
+     *         and the given variables in data_2. The rows are at the times 0, 1, 2, ...
+     *
+     * The aliases follow the variables in the name matrix. If singlePrecision is true, data_1 and data_2 are stored
+     * as float.
+     */
+    void writeTransposedMatFile(const std::string& fileName, const std::vector<std::string>& paramNames,
+                                const std::vector<double>& paramValues, const std::vector<std::string>& varNames,
+                                const std::size_t numRows, const std::function<void(std::size_t, double*)>& fillRow,
+                                const std::vector<MatAlias>& aliases = {}, const bool singlePrecision = false)
+    {
+        std::ofstream out(fileName, std::ios::binary);
+        auto writeValues = [&out, singlePrecision](const double* values, const std::size_t n)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                const float valueF = static_cast<float>(values[i]);
+                if (singlePrecision)
+                    out.write(reinterpret_cast<const char*>(&valueF), sizeof(float));
+                else
+                    out.write(reinterpret_cast<const char*>(values + i), sizeof(double));
+            }
+        };
+        const std::int32_t dataType = singlePrecision ? 10 : 0;
+
+        const char aclass[4][12] = { "Atrajectory", "1.1        ", "           ", "binTrans   " };
+        writeMatHeader(out, 51, 4, 11, "Aclass");
+        for (std::size_t c = 0; c < 11; ++c)
+        {
+            for (std::size_t r = 0; r < 4; ++r)
+                out.put(aclass[r][c]);
+        }
+
+        std::vector<std::string> names(1, "time");
+        names.insert(names.end(), paramNames.begin(), paramNames.end());
+        names.insert(names.end(), varNames.begin(), varNames.end());
+        for (const auto& alias : aliases)
+            names.push_back(alias.name);
+        std::size_t maxLen = 1;
+        for (const auto& name : names)
+            maxLen = std::max(maxLen, name.size());
+        writeMatHeader(out, 51, maxLen, names.size(), "name");
+        for (auto name : names)
+        {
+            name.resize(maxLen, ' ');
+            out.write(name.data(), maxLen);
+        }
+        writeMatHeader(out, 51, 1, names.size(), "description");
+        out.write(std::string(names.size(), ' ').data(), names.size());
+
+        writeMatHeader(out, 20, 4, names.size(), "dataInfo");
+        std::vector<std::int32_t> info = { 0, 1, 0, -1 };
+        for (std::size_t i = 0; i < paramNames.size(); ++i)
+            info.insert(info.end(), { 1, static_cast<std::int32_t>(i + 2), 0, 0 });
+        for (std::size_t i = 0; i < varNames.size(); ++i)
+            info.insert(info.end(), { 2, static_cast<std::int32_t>(i + 2), 0, -1 });
+        for (const auto& alias : aliases)
+            info.insert(info.end(), { alias.dataSet, alias.column, 0, (1 == alias.dataSet) ? 0 : -1 });
+        out.write(reinterpret_cast<const char*>(info.data()), info.size() * sizeof(std::int32_t));
+
+        writeMatHeader(out, dataType, 1 + paramNames.size(), 2, "data_1");
+        for (const double time : { 0.0, static_cast<double>(numRows - 1) })
+        {
+            writeValues(&time, 1);
+            writeValues(paramValues.data(), paramValues.size());
+        }
+
+        writeMatHeader(out, dataType, 1 + varNames.size(), numRows, "data_2");
+        std::vector<double> row(1 + varNames.size());
+        for (std::size_t rowIdx = 0; rowIdx < numRows; ++rowIdx)
+        {
+            row[0] = static_cast<double>(rowIdx);
+            fillRow(rowIdx, row.data() + 1);
+            writeValues(row.data(), row.size());
+        }
+    }
+}
+
+/*! \brief Class to test the memory-mapped MAT file reader \ref Model::MatResultFile.
+ */
+class TestMatResultFile : public ::testing::Test
+{
+ public:
+    OMVIS::Model::MatResultFile _matFile;
+
+    TestMatResultFile()
+            : _matFile()
+    {
+    }
+
+    void SetUp()
+    {
+        _matFile.open("examples/pendulum_res.mat");
+    }
+
+    void TearDown()
+    {
+        _matFile.close();
+    }
+
+    ~TestMatResultFile()
+    {
+    }
+};
+
+/*!
+ * Test that the time axis of the result file is read correctly.
+ */
+TEST_F (TestMatResultFile, TimeAxis)
+{
+    ASSERT_TRUE(_matFile.isOpen());
+    EXPECT_EQ(502u, _matFile.getNumRows());
+    EXPECT_DOUBLE_EQ(0.0, _matFile.getStartTime());
+    EXPECT_DOUBLE_EQ(10.0, _matFile.getStopTime());
+}
+
+/*!
+ * Test the lookup of parameters, variables and non-existing variables.
+ */
+TEST_F (TestMatResultFile, FindVariable)
+{
+    OMVIS::Model::MatColumn column;
+    EXPECT_TRUE(_matFile.findVariable("world.axisDiameter", column));
+    EXPECT_EQ(0u, column.rowStride);
+    EXPECT_TRUE(_matFile.findVariable("body.r_0[1]", column));
+    EXPECT_FALSE(_matFile.findVariable("noSuchVariable", column));
+}
+
+/*!
+ * Test that the cursor interpolates correctly when moving forward, backward and jumping.
+ */
+TEST_F (TestMatResultFile, Seek)
+{
+    OMVIS::Model::MatColumn time;
+    ASSERT_TRUE(_matFile.findVariable("time", time));
+
+    for (double t : { 0.0, 0.31, 0.33, 0.29, 4.9, 0.5 })
+    {
+        _matFile.seek(t);
+        EXPECT_NEAR(t, _matFile.getValue(time), 1.e-12);
+    }
+
+    // Times outside of the result are clamped.
+    _matFile.seek(100.0);
+    EXPECT_DOUBLE_EQ(10.0, _matFile.getValue(time));
+    _matFile.seek(-1.0);
+    EXPECT_DOUBLE_EQ(0.0, _matFile.getValue(time));
+}
+
+/*!
+ * Test that selectively loaded variables, including negated aliases, yield the same values as the full file.
+ */
+TEST_F (TestMatResultFile, SelectiveLoading)
+{
+    std::vector<std::string> varNames = { "body.r_0[1]", "world.axisDiameter", "fixedTranslation.frame_b.f[1]" };
+    OMVIS::Model::MatResultFile selected;
+    selected.open("examples/pendulum_res.mat", varNames);
+    EXPECT_EQ(_matFile.getNumRows(), selected.getNumRows());
+
+    OMVIS::Model::MatColumn column;
+    EXPECT_FALSE(selected.findVariable("revolute.phi", column));
+
+    for (const auto& varName : varNames)
+    {
+        OMVIS::Model::MatColumn full, sel;
+        ASSERT_TRUE(_matFile.findVariable(varName, full));
+        ASSERT_TRUE(selected.findVariable(varName, sel));
+        for (double t : { 0.0, 0.31, 2.5, 10.0 })
+        {
+            _matFile.seek(t);
+            selected.seek(t);
+            EXPECT_DOUBLE_EQ(_matFile.getValue(full), selected.getValue(sel));
+        }
+    }
+}
+
+/*!
+ * Test that selectively loading a transposed file yields the stored values and releases the decoded rows in chunks.
+ */
+TEST (TestMatResultFileTransposed, SelectiveLoading)
+{
+    // More rows than are decoded before the mapped rows are released.
+    const std::size_t numRows = 10000;
+    const std::string fileName = "TestMatResultFileTransposed.mat";
+    writeTransposedMatFile(fileName, { "p" }, { 3.0 }, { "a", "b", "c" }, numRows,
+                           [](std::size_t row, double* values)
+                           {
+                               values[0] = static_cast<double>(row);
+                               values[1] = 2.0 * row + 1.0;
+                               values[2] = -1.0;
+                           });
+
+    OMVIS::Model::MatResultFile selected;
+    selected.open(fileName, { "a", "b", "p" });
+    ASSERT_TRUE(selected.isOpen());
+    EXPECT_EQ(numRows, selected.getNumRows());
+    // Two chunks of rows while decoding and the whole data_2 block afterwards.
+    EXPECT_EQ(3u, selected.getNumReleasedRanges());
+
+    OMVIS::Model::MatColumn a, b, p, c;
+    ASSERT_TRUE(selected.findVariable("a", a));
+    ASSERT_TRUE(selected.findVariable("b", b));
+    ASSERT_TRUE(selected.findVariable("p", p));
+    EXPECT_FALSE(selected.findVariable("c", c));
+
+    for (double t : { 0.0, 1.0, 4095.0, 4096.5, 8191.25, 9999.0 })
+    {
+        selected.seek(t);
+        EXPECT_DOUBLE_EQ(t, selected.getValue(a));
+        EXPECT_DOUBLE_EQ(2.0 * t + 1.0, selected.getValue(b));
+        EXPECT_DOUBLE_EQ(3.0, selected.getValue(p));
+    }
+
+    selected.close();
+    std::remove(fileName.c_str());
+}
+
+/*!
+ * Test that matrix headers with unsupported types, negative dimensions or sizes beyond the end of the file are
+ * rejected.
+ */
+TEST (TestMatResultFileCorrupt, InvalidHeaders)
+{
+    const std::string fileName = "TestMatResultFileCorrupt.mat";
+    // Type, rows and columns of the first matrix. The product of the rows and columns wraps around.
+    const std::vector<std::vector<std::int32_t>> headers = { { 100, 1, 1 }, { -10, 1, 1 }, { 0, -1, 1 },
+                                                             { 0, 1, -1 }, { 0, 0x7fffffff, 0x7fffffff } };
+    for (const auto& header : headers)
+    {
+        {
+            std::ofstream out(fileName, std::ios::binary);
+            writeMatHeader(out, header[0], static_cast<std::size_t>(header[1]), static_cast<std::size_t>(header[2]),
+                           "data_2");
+            const double value = 1.0;
+            out.write(reinterpret_cast<const char*>(&value), sizeof(double));
+        }
+
+        OMVIS::Model::MatResultFile matFile;
+        EXPECT_THROW(matFile.open(fileName), std::runtime_error);
+        EXPECT_FALSE(matFile.isOpen());
+    }
+    std::remove(fileName.c_str());
+}
+
+/*!
+ * Test that the batched interpolation yields the same values as \ref OMVIS::Model::MatResultFile::getValue for every
+ * column, including parameters and negated aliases, in double precision (AVX2 kernel, if enabled) and in single
+ * precision (scalar loop), for the mapped and for the selectively loaded file.
+ */
+TEST (TestMatResultFileBatch, InterpolateMatchesGetValue)
+{
+    const std::string fileName = "TestMatResultFileBatch.mat";
+    const std::size_t numRows = 50;
+    const std::size_t numVars = 7;
+    std::vector<std::string> names = { "time", "p1", "p2" };
+    std::vector<std::string> varNames;
+    for (std::size_t i = 0; i < numVars; ++i)
+        varNames.push_back("x" + std::to_string(i));
+    names.insert(names.end(), varNames.begin(), varNames.end());
+    const std::vector<MatAlias> aliases = { { "minusX2", 2, -4 }, { "x5Alias", 2, 7 }, { "minusP2", 1, -3 } };
+    for (const auto& alias : aliases)
+        names.push_back(alias.name);
+
+    for (const bool singlePrecision : { false, true })
+    {
+        writeTransposedMatFile(fileName, { "p1", "p2" }, { 0.25, -4.0 }, varNames, numRows,
+                               [numVars](std::size_t row, double* values)
+                               {
+                                   for (std::size_t i = 0; i < numVars; ++i)
+                                       values[i] = std::sin(0.3 * row + i) * (1.0 + i);
+                               },
+                               aliases, singlePrecision);
+
+        for (const bool selective : { false, true })
+        {
+            OMVIS::Model::MatResultFile matFile;
+            if (selective)
+                matFile.open(fileName, names);
+            else
+                matFile.open(fileName);
+
+            std::vector<OMVIS::Model::MatColumn> columns(names.size());
+            OMVIS::Model::MatColumnBatch batch;
+            for (std::size_t i = 0; i < names.size(); ++i)
+            {
+                ASSERT_TRUE(matFile.findVariable(names[i], columns[i])) << names[i];
+                matFile.addToBatch(columns[i], batch);
+            }
+            ASSERT_EQ(names.size(), batch.size());
+
+            std::vector<float> values(batch.size());
+            // Forward playback, backward playback, jumps and times outside of the result.
+            for (double t : { 0.0, 0.4, 0.9, 1.3, 2.0, 2.7, 2.2, 1.6, 0.1, 37.5, 3.25, 49.0, 60.0, -1.0 })
+            {
+                matFile.seek(t);
+                matFile.interpolate(batch, values.data());
+                for (std::size_t i = 0; i < names.size(); ++i)
+                {
+                    const double expected = matFile.getValue(columns[i]);
+                    EXPECT_NEAR(expected, values[i], 1.e-6 * (1.0 + std::abs(expected))) << names[i] << " at " << t;
+                }
+            }
+
+            EXPECT_DOUBLE_EQ(-matFile.getValue(columns[5]), matFile.getValue(columns[names.size() - 3]));
+            EXPECT_DOUBLE_EQ(4.0, matFile.getValue(columns.back()));
+        }
+    }
+    std::remove(fileName.c_str());
+}
+
+#endif /* TEST_INCLUDE_TESTMATRESULTFILE_HPP_ */
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_INCLUDE_TESTSTAGESTATISTICS_HPP_
+#define TEST_INCLUDE_TESTSTAGESTATISTICS_HPP_
+
+#include "Util/StageStatistics.hpp"
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+/*! \brief Test that the percentiles of a \ref OMVIS::Util::StageHistogram are accurate to one bucket. */
+TEST (TestStageStatistics, HistogramPercentiles)
+{
+    OMVIS::Util::StageHistogram histogram;
+    OMVIS::Util::StageHistogram empty;
+    EXPECT_EQ(0.0, histogram.getPercentile(0.5, empty));
+
+    // 1 ms to 100 ms.
+    for (int i = 1; i <= 100; ++i)
+        histogram.add(1.e-3 * i);
+    EXPECT_EQ(100u, histogram.getNumSamples());
+
+    const double bucketWidth = std::exp2(1.0 / OMVIS::Util::StageHistogram::subBuckets);
+    const double p50 = histogram.getPercentile(0.5, empty);
+    const double p99 = histogram.getPercentile(0.99, empty);
+    EXPECT_LE(50.e-3, p50);
+    EXPECT_GE(50.e-3 * bucketWidth, p50);
+    EXPECT_LE(99.e-3, p99);
+    EXPECT_GE(99.e-3 * bucketWidth, p99);
+
+    // The samples of the other histogram count as well.
+    EXPECT_EQ(p50, empty.getPercentile(0.5, histogram));
+}
+
+/*! \brief Test that the samples of several threads are collected and that full rings drop samples. */
+TEST (TestStageStatistics, CollectFromThreads)
+{
+    OMVIS::Util::StageStatistics statistics;
+    const std::size_t numThreads = 4;
+    const std::size_t numSamples = 100;
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([&statistics, t, numSamples]() {
+            for (std::size_t i = 0; i < numSamples; ++i)
+                statistics.record(OMVIS::Util::FS_FETCH, 1.e-3 * (t + 1));
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    statistics.collect();
+    EXPECT_EQ(numThreads * numSamples, statistics.getNumSamples(OMVIS::Util::FS_FETCH));
+    EXPECT_EQ(0u, statistics.getNumSamples(OMVIS::Util::FS_RENDER));
+    EXPECT_LE(4.e-3, statistics.getPercentile(OMVIS::Util::FS_FETCH, 0.99));
+    EXPECT_EQ(0u, statistics.getNumDropped());
+
+    // Without collecting, the ring of a thread runs full.
+    for (std::size_t i = 0; i < OMVIS::Util::StageStatistics::ringSize + 10; ++i)
+        statistics.record(OMVIS::Util::FS_RENDER, 1.e-3);
+    EXPECT_EQ(10u, statistics.getNumDropped());
+
+    statistics.reset();
+    statistics.collect();
+    EXPECT_EQ(0u, statistics.getNumSamples(OMVIS::Util::FS_FETCH));
+    EXPECT_EQ(0u, statistics.getNumSamples(OMVIS::Util::FS_RENDER));
+}
+
+/*! \brief Test that the rings of exited threads are reused by new threads and keep their samples. */
+TEST (TestStageStatistics, RecycleRings)
+{
+    OMVIS::Util::StageStatistics statistics;
+    const std::size_t numThreads = 4;
+    const std::size_t numRounds = 10;
+    const std::size_t numSamples = 50;
+
+    // Like a new thread pool for every loaded model.
+    for (std::size_t round = 0; round < numRounds; ++round)
+    {
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < numThreads; ++t)
+        {
+            threads.emplace_back([&statistics, numSamples]() {
+                for (std::size_t i = 0; i < numSamples; ++i)
+                    statistics.record(OMVIS::Util::FS_TRANSFORM, 1.e-3);
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+        EXPECT_GE(numThreads, statistics.getNumRings());
+        statistics.collect();
+    }
+
+    EXPECT_EQ(numRounds * numThreads * numSamples, statistics.getNumSamples(OMVIS::Util::FS_TRANSFORM));
+    EXPECT_EQ(0u, statistics.getNumDropped());
+}
+
+#endif /* TEST_INCLUDE_TESTSTAGESTATISTICS_HPP_ */
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_INCLUDE_TESTSYNTHETICMODEL_HPP_
+#define TEST_INCLUDE_TESTSYNTHETICMODEL_HPP_
+
+#include "SyntheticData.hpp"
+#include "Model/VisualizerMAT.hpp"
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+
+/*! \brief Class to test that the synthetic models of the generator are visualized with the expected number of
+ *         constant and dynamic shapes.
+ */
+class TestSyntheticModel : public ::testing::Test
+{
+ public:
+    /*! \brief Writes the given model, plays some frames and checks the shape table. */
+    void checkModel(const SyntheticModel& model, const std::size_t numFrames)
+    {
+        const std::string path = boost::filesystem::temp_directory_path().string() + "/";
+        const std::string name = "TestSyntheticModel" + std::to_string(model.numShapes);
+        writeSyntheticModel(path, name, model);
+
+        const std::size_t numDynamic = static_cast<std::size_t>(std::floor(model.numShapes * model.dynamicFraction));
+        {
+            OMVIS::Model::VisualizerMAT visualizer(name + "_res.mat", path);
+            visualizer.initialize();
+            const auto& table = visualizer.getBaseData()->_shapeTable;
+            EXPECT_EQ(model.numShapes, table.getNumShapes());
+            EXPECT_EQ(model.numShapes - numDynamic, table.getConstShapes().size());
+            EXPECT_EQ(13 * numFrames, table.getNumVariables());
+
+            // All frames move, thus every dynamic shape is updated.
+            visualizer.getTimeManager()->setPause(false);
+            for (int i = 0; i < 5; ++i)
+            {
+                visualizer.sceneUpdate();
+                EXPECT_EQ(numDynamic, visualizer.getNumUpdatedShapes());
+            }
+        }
+        std::remove((path + name + "_res.mat").c_str());
+        std::remove((path + name + "_visual.xml").c_str());
+    }
+};
+
+/*!
+ * Test a small model with one frame per dynamic shape.
+ */
+TEST_F (TestSyntheticModel, Shapes10)
+{
+    SyntheticModel model;
+    model.numShapes = 10;
+    model.numRows = 100;
+    model.dynamicFraction = 0.25;
+    checkModel(model, 2);
+}
+
+/*!
+ * Test a larger model whose dynamic shapes share a few frames.
+ */
+TEST_F (TestSyntheticModel, Shapes1000)
+{
+    SyntheticModel model;
+    model.numShapes = 1000;
+    model.numRows = 100;
+    model.dynamicFraction = 0.25;
+    model.numFrames = 8;
+    checkModel(model, 8);
+}
+
+#endif /* TEST_INCLUDE_TESTSYNTHETICMODEL_HPP_ */
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_INCLUDE_TESTTHREADPOOL_HPP_
+#define TEST_INCLUDE_TESTTHREADPOOL_HPP_
+
+#include "Util/ThreadPool.hpp"
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/*! \brief Calls parallelFor and checks that every index of [0, size) is visited exactly once. */
+static void expectEachIndexOnce(OMVIS::Util::ThreadPool& pool, const std::size_t size, const std::size_t grainSize)
+{
+    std::unique_ptr<std::atomic<int>[]> visits(new std::atomic<int>[size + 1]);
+    for (std::size_t i = 0; i <= size; ++i)
+        visits[i] = 0;
+
+    // Without workers, the whole range is one chunk.
+    const std::size_t maxChunkSize = (1 < pool.getNumThreads()) ? grainSize : size;
+    std::atomic<bool> validChunks(true);
+    pool.parallelFor(size, grainSize, [&](const std::size_t begin, const std::size_t end)
+    {
+        if (begin >= end || end > size || end - begin > maxChunkSize)
+            validChunks = false;
+        for (std::size_t i = begin; i < end; ++i)
+            ++visits[i];
+    });
+
+    EXPECT_TRUE(validChunks) << "size " << size << ", grain size " << grainSize;
+    for (std::size_t i = 0; i < size; ++i)
+        ASSERT_EQ(1, visits[i]) << "index " << i << ", size " << size << ", grain size " << grainSize;
+    EXPECT_EQ(0, visits[size]);
+}
+
+/*!
+ * Test that parallelFor visits each index exactly once for empty, small, odd and large ranges.
+ */
+TEST (TestThreadPool, EachIndexOnce)
+{
+    const std::size_t grainSize = 64;
+    OMVIS::Util::ThreadPool pool(3);
+    EXPECT_EQ(4u, pool.getNumThreads());
+
+    for (const std::size_t size : { std::size_t(0), std::size_t(1), grainSize - 1, grainSize, grainSize + 1,
+                                    std::size_t(100003) })
+        expectEachIndexOnce(pool, size, grainSize);
+
+    // Without workers, the calling thread does the whole loop.
+    OMVIS::Util::ThreadPool serial(0);
+    expectEachIndexOnce(serial, 1000, grainSize);
+}
+
+/*!
+ * Test that consecutive loops on the same pool neither lose nor repeat indices.
+ */
+TEST (TestThreadPool, RepeatedCalls)
+{
+    OMVIS::Util::ThreadPool pool(3);
+    for (std::size_t k = 0; k < 200; ++k)
+        expectEachIndexOnce(pool, 1 + 97 * k, 1 + k % 13);
+}
+
+#endif /* TEST_INCLUDE_TESTTHREADPOOL_HPP_ */
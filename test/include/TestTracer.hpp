@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_INCLUDE_TESTTRACER_HPP_
+#define TEST_INCLUDE_TESTTRACER_HPP_
+
+#include "SyntheticData.hpp"
+#include "Util/Tracer.hpp"
+#include <gtest/gtest.h>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <cstdio>
+#include <set>
+#include <thread>
+#include <vector>
+
+/*! \brief Test that the events of several threads are written as valid Chrome trace and that nothing is recorded
+ *         before the tracer is started.
+ */
+TEST (TestTracer, WritesChromeTrace)
+{
+    OMVIS::Util::Tracer& tracer = OMVIS::Util::Tracer::getInstance();
+    {
+        OMVIS::Util::TraceScope ignored("ignored", "test");
+    }
+
+    const std::string fileName = getTemporaryFileName(".json");
+    tracer.start(fileName);
+    const std::size_t numThreads = 3;
+    const std::size_t numEvents = 1000;
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([numEvents]() {
+            for (std::size_t i = 0; i < numEvents; ++i)
+            {
+                OMVIS::Util::TraceScope outer("outer", "test");
+                OMVIS::Util::TraceScope inner("inner", "test");
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    tracer.stop();
+
+    boost::property_tree::ptree trace;
+    ASSERT_NO_THROW(boost::property_tree::read_json(fileName, trace));
+    std::remove(fileName.c_str());
+
+    std::size_t numOuter = 0;
+    std::size_t numInner = 0;
+    std::set<int> threadIds;
+    for (const auto& event : trace.get_child("traceEvents"))
+    {
+        const std::string name = event.second.get<std::string>("name");
+        EXPECT_NE("ignored", name);
+        if ("X" != event.second.get<std::string>("ph"))
+            continue;
+        EXPECT_LE(0.0, event.second.get<double>("dur"));
+        threadIds.insert(event.second.get<int>("tid"));
+        numOuter += ("outer" == name) ? 1 : 0;
+        numInner += ("inner" == name) ? 1 : 0;
+    }
+    EXPECT_EQ(numThreads * numEvents, numOuter);
+    EXPECT_EQ(numThreads * numEvents, numInner);
+    EXPECT_EQ(numThreads, threadIds.size());
+}
+
+#endif /* TEST_INCLUDE_TESTTRACER_HPP_ */
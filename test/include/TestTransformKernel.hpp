@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_INCLUDE_TESTTRANSFORMKERNEL_HPP_
+#define TEST_INCLUDE_TESTTRANSFORMKERNEL_HPP_
+
+#include "Model/ShapeTable.hpp"
+#include "Util/Visualize.hpp"
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+/*! \brief Reference for the kernel: Computes the matrix of one shape by \ref OMVIS::Util::rotation and
+ *         \ref OMVIS::Util::assemblePokeMatrix and scales the unit primitives to the size of the shape.
+ */
+static osg::Matrix computeReferenceMatrix(const OMVIS::Model::ShapeObject& shape)
+{
+    OMVIS::Util::rAndT rT = OMVIS::Util::rotation(
+            osg::Vec3f(shape._r[0].exp, shape._r[1].exp, shape._r[2].exp),
+            osg::Vec3f(shape._rShape[0].exp, shape._rShape[1].exp, shape._rShape[2].exp),
+            osg::Matrix3(shape._T[0].exp, shape._T[1].exp, shape._T[2].exp, shape._T[3].exp, shape._T[4].exp,
+                         shape._T[5].exp, shape._T[6].exp, shape._T[7].exp, shape._T[8].exp),
+            osg::Vec3f(shape._lDir[0].exp, shape._lDir[1].exp, shape._lDir[2].exp),
+            osg::Vec3f(shape._wDir[0].exp, shape._wDir[1].exp, shape._wDir[2].exp), shape._length.exp, shape._type);
+
+    osg::Matrix mat;
+    OMVIS::Util::assemblePokeMatrix(mat, rT._T, rT._r);
+    if (shape._type == "box")
+        mat.preMultScale(osg::Vec3d(shape._width.exp, shape._height.exp, shape._length.exp));
+    else if (shape._type == "cylinder" || shape._type == "cone")
+        mat.preMultScale(osg::Vec3d(shape._width.exp, shape._width.exp, shape._length.exp));
+    else if (shape._type == "sphere")
+        mat.preMultScale(osg::Vec3d(shape._length.exp, shape._length.exp, shape._length.exp));
+    return mat;
+}
+
+/*! \brief Test that the batched kernel \ref OMVIS::Util::transformBatch computes the same matrices as
+ *         \ref OMVIS::Util::rotation and \ref OMVIS::Util::assemblePokeMatrix for all shape types, including
+ *         degenerate directions.
+ */
+TEST (TestTransformKernel, MatchesRotation)
+{
+    const std::vector<std::string> types = { "box", "cylinder", "sphere", "cone", "pipecylinder", "spring", "pipe",
+                                             "stl", "dxf", "modelica://Modelica/Resources/Data/Shapes/piston.dxf" };
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> distribution(-2.0f, 2.0f);
+
+    // An odd number of shapes, such that the scalar remainder of the kernel is used, too.
+    std::vector<OMVIS::Model::ShapeObject> shapes(101);
+    for (std::size_t i = 0; i < shapes.size(); ++i)
+    {
+        auto& shape = shapes[i];
+        shape._type = types[i % types.size()];
+        shape._shapeType = OMVIS::Model::getShapeTypeForString(shape._type);
+        for (auto attr : shape.getAttributes())
+            attr->exp = distribution(generator);
+
+        // Vanishing length direction.
+        if (0 == i % 7)
+            shape._lDir[0].exp = shape._lDir[1].exp = shape._lDir[2].exp = 0.0f;
+        // Width direction parallel to the length direction.
+        if (0 == i % 5)
+        {
+            for (int k = 0; k < 3; ++k)
+                shape._wDir[k].exp = 2.0f * shape._lDir[k].exp;
+        }
+    }
+
+    OMVIS::Model::ShapeTable table;
+    table.build(shapes);
+    double* matrices = table.getMatrices();
+    OMVIS::Util::transformBatch(table.getTransformInputs(), 0, shapes.size(), matrices);
+
+    for (std::size_t i = 0; i < shapes.size(); ++i)
+    {
+        const osg::Matrix reference = computeReferenceMatrix(shapes[i]);
+        const double* expected = reference.ptr();
+        for (int k = 0; k < 16; ++k)
+            EXPECT_NEAR(expected[k], matrices[16 * i + k], 1.e-5) << shapes[i]._type << ", element " << k;
+    }
+}
+
+#endif /* TEST_INCLUDE_TESTTRANSFORMKERNEL_HPP_ */
@@ -86,6 +86,25 @@ TEST_F (TestOMVisualBase, initXMLFile)
     std::vector<std::string> viVars = _omVisualBase->getVisualizationVariables();
     EXPECT_EQ(1, viVars.size());
     EXPECT_EQ("shape.r[2]", viVars.at(0));
+
+    // Only r[2] is not constant.
+    OMVIS::Model::ShapeTable& table = _omVisualBase->_shapeTable;
+    EXPECT_EQ(1, table.getNumShapes());
+    ASSERT_EQ(1, table.getNumVariables());
+    EXPECT_EQ("shape.r[2]", table.getVariable(0));
+    EXPECT_FALSE(table.isConst(0, OMVIS::Model::SA_R + 2));
+    EXPECT_TRUE(table.isConst(0, OMVIS::Model::SA_R));
+
+    // The shape is dirty after the table has been built and only again, if r[2] changes.
+    EXPECT_EQ(1, table.getDynamicShapes().size());
+    EXPECT_TRUE(table.isDirty(0));
+    table.clearDirty();
+    table.getVariableValues()[0] = table.getValues(OMVIS::Model::SA_R + 2)[0];
+    table.scatter();
+    EXPECT_FALSE(table.isDirty(0));
+    table.getVariableValues()[0] += 1.0f;
+    table.scatter();
+    EXPECT_TRUE(table.isDirty(0));
 }
 
 /*!